@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "PerfCounters.hpp"
+
+// Wall-clock timer
+class BenchTimer{
+    private:
+        std::chrono::steady_clock::time_point Start;
+
+    public:
+        BenchTimer() : Start(std::chrono::steady_clock::now()) {}
+        void reset(){ Start = std::chrono::steady_clock::now(); }
+        double seconds() const{
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+        }
+};
+
+// Keep the optimiser from discarding a result
+template<typename T>
+inline void doNotOptimize(const T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Timing summary of one benchmark. Samples are seconds per call; the median and the
+// median absolute deviation are used because they ignore the occasional preempted run
+struct BenchStats{
+    std::string Name;
+    std::string Unit;
+    double ItemsPerCall = 0.0;
+    std::vector<double> Samples;
+    double Median = 0.0;
+    double MAD = 0.0;
+    double Min = 0.0;
+
+    // Hardware counts per item over the timed repetitions (NaN when unavailable), and the
+    // model steps in one item so path benchmarks can also be read per step
+    double Counters[PerfCounters::NumEvents] = {NAN, NAN, NAN, NAN, NAN};
+    double StepsPerItem = 0.0;
+
+    double throughput() const { return Median > 0.0 ? ItemsPerCall / Median : 0.0; }
+};
+
+// Command-line settings shared by the benchmark executables
+struct BenchOptions{
+    unsigned int Warmup = 2;
+    unsigned int Repetitions = 15;
+    double MinSampleSeconds = 0.02;
+    std::string Filter;
+    bool Counters = true;
+
+    // Parse --warmup N, --reps N, --min-time S, --filter TEXT and --no-counters
+    static BenchOptions parse(int argc, char** argv){
+        BenchOptions options;
+        for (int i = 1; i < argc; ++i){
+            if (std::strcmp(argv[i], "--no-counters") == 0){
+                options.Counters = false;
+                continue;
+            }
+            if (i + 1 >= argc){
+                std::fprintf(stderr, "Ignoring unknown option %s\n", argv[i]);
+                break;
+            }
+            if (std::strcmp(argv[i], "--warmup") == 0) options.Warmup = std::atoi(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--reps") == 0) options.Repetitions = std::max(1, std::atoi(argv[i + 1]));
+            else if (std::strcmp(argv[i], "--min-time") == 0) options.MinSampleSeconds = std::atof(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--filter") == 0) options.Filter = argv[i + 1];
+            else{
+                std::fprintf(stderr, "Ignoring unknown option %s\n", argv[i]);
+                continue;
+            }
+            ++i;
+        }
+        return options;
+    }
+
+    bool selected(const std::string& name) const { return Filter.empty() || name.find(Filter) != std::string::npos; }
+};
+
+inline double median(std::vector<double> values){
+    if (values.empty()) return 0.0;
+    std::size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double upper = values[mid];
+    if (values.size() % 2 == 1) return upper;
+    return 0.5 * (upper + *std::max_element(values.begin(), values.begin() + mid));
+}
+
+inline double medianAbsoluteDeviation(const std::vector<double>& values, double centre){
+    std::vector<double> deviations;
+    for (double v : values) deviations.push_back(std::fabs(v - centre));
+    return median(deviations);
+}
+
+// Shared hardware counters, or nullptr when disabled or not permitted on this machine
+inline PerfCounters* benchCounters(const BenchOptions& options){
+    static PerfCounters counters;
+    static bool warned = false;
+    if (!options.Counters) return nullptr;
+    if (!counters.available()){
+        if (!warned){
+            std::fprintf(stderr, "Hardware counters unavailable (perf_event_open failed; check "
+                                 "/proc/sys/kernel/perf_event_paranoid); reporting timings only\n");
+            warned = true;
+        }
+        return nullptr;
+    }
+    return &counters;
+}
+
+// Time fn(), which does itemsPerCall units of work. Warmup calls also size the number of
+// calls per sample so each sample lasts at least MinSampleSeconds
+template<typename Fn>
+BenchStats runBenchmark(const BenchOptions& options, const std::string& name, const std::string& unit,
+                        double itemsPerCall, Fn fn){
+    BenchStats stats;
+    stats.Name = name;
+    stats.Unit = unit;
+    stats.ItemsPerCall = itemsPerCall;
+
+    unsigned long callsPerSample = 1;
+    for (unsigned int w = 0; w < std::max(options.Warmup, 1u); ++w){
+        BenchTimer timer;
+        for (unsigned long c = 0; c < callsPerSample; ++c) fn();
+        double elapsed = timer.seconds();
+        while (elapsed * 2 < options.MinSampleSeconds && callsPerSample < (1ul << 30)){
+            callsPerSample *= 2;
+            elapsed *= 2;
+        }
+    }
+
+    PerfCounters* counters = benchCounters(options);
+    if (counters != nullptr) counters->start();
+    for (unsigned int r = 0; r < options.Repetitions; ++r){
+        BenchTimer timer;
+        for (unsigned long c = 0; c < callsPerSample; ++c) fn();
+        stats.Samples.push_back(timer.seconds() / callsPerSample);
+    }
+    if (counters != nullptr){
+        counters->stop();
+        double items = itemsPerCall * callsPerSample * options.Repetitions;
+        for (int e = 0; e < PerfCounters::NumEvents; ++e){
+            stats.Counters[e] = counters->read(static_cast<PerfCounters::Event>(e)) / items;
+        }
+    }
+    stats.Median = median(stats.Samples);
+    stats.MAD = medianAbsoluteDeviation(stats.Samples, stats.Median);
+    stats.Min = *std::min_element(stats.Samples.begin(), stats.Samples.end());
+    return stats;
+}
+
+inline void printHeader(){
+    std::printf("%-48s %14s %10s %8s %16s\n", "benchmark", "median", "MAD", "MAD %", "throughput");
+}
+
+inline void printResult(const BenchStats& stats){
+    double madPercent = stats.Median > 0.0 ? 100.0 * stats.MAD / stats.Median : 0.0;
+    std::printf("%-48s %11.3f us %7.3f us %7.2f%% %12.4g %s/s\n", stats.Name.c_str(), stats.Median * 1e6,
+                stats.MAD * 1e6, madPercent, stats.throughput(), stats.Unit.c_str());
+
+    // Counter line: per item figures, IPC, and cycles per model step where that applies
+    const double* c = stats.Counters;
+    if (!std::isnan(c[PerfCounters::Cycles]) || !std::isnan(c[PerfCounters::Instructions])){
+        std::string unit = stats.Unit.empty() ? "item" : stats.Unit.substr(0, stats.Unit.size() - 1);
+        std::printf("    cycles/%s %.4g  IPC %.3g  L1d miss/%s %.4g  LLC miss/%s %.4g  br miss/%s %.4g",
+                    unit.c_str(), c[PerfCounters::Cycles], c[PerfCounters::Instructions] / c[PerfCounters::Cycles],
+                    unit.c_str(), c[PerfCounters::L1DMisses], unit.c_str(), c[PerfCounters::LLCMisses],
+                    unit.c_str(), c[PerfCounters::BranchMisses]);
+        if (stats.StepsPerItem > 0.0){
+            std::printf("  cycles/step %.4g", c[PerfCounters::Cycles] / stats.StepsPerItem);
+        }
+        std::printf("\n");
+    }
+    std::fflush(stdout);
+}
+
+// Nearest-rank percentile, p in [0, 100]
+inline double percentile(std::vector<double> values, double p){
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * values.size()));
+    return values[std::min(values.size(), std::max<std::size_t>(rank, 1)) - 1];
+}
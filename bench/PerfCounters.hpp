@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters read around a measured region with perf_event_open. Each counter is
+// opened on its own so a machine that lacks one (or a VM that exposes none) still reports
+// the rest; unavailable counters read as NaN. Counts follow the calling thread and the
+// threads it starts while counting, and are scaled for multiplexing
+class PerfCounters{
+    public:
+        enum Event{ Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses, NumEvents };
+
+        PerfCounters(){
+            for (int e = 0; e < NumEvents; ++e) Fds[e] = -1;
+#ifdef __linux__
+            const std::uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                              | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            Fds[Cycles] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            Fds[Instructions] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            Fds[L1DMisses] = open(PERF_TYPE_HW_CACHE, l1dReadMiss);
+            Fds[LLCMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+            Fds[BranchMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+        }
+
+        ~PerfCounters(){
+#ifdef __linux__
+            for (int e = 0; e < NumEvents; ++e){
+                if (Fds[e] >= 0) ::close(Fds[e]);
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool available() const{
+            for (int e = 0; e < NumEvents; ++e){
+                if (Fds[e] >= 0) return true;
+            }
+            return false;
+        }
+
+        void start(){
+#ifdef __linux__
+            for (int e = 0; e < NumEvents; ++e){
+                if (Fds[e] < 0) continue;
+                ioctl(Fds[e], PERF_EVENT_IOC_RESET, 0);
+                ioctl(Fds[e], PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        void stop(){
+#ifdef __linux__
+            for (int e = 0; e < NumEvents; ++e){
+                if (Fds[e] >= 0) ioctl(Fds[e], PERF_EVENT_IOC_DISABLE, 0);
+            }
+#endif
+        }
+
+        // Count since start(), scaled by enabled / running time; NaN if unavailable
+        double read(Event e) const{
+#ifdef __linux__
+            std::uint64_t values[3];
+            if (Fds[e] >= 0 && ::read(Fds[e], values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)) && values[2] > 0){
+                return static_cast<double>(values[0]) * values[1] / values[2];
+            }
+#endif
+            (void)e;
+            return NAN;
+        }
+
+        static const char* name(Event e){
+            static const char* names[NumEvents] = {"cycles", "instructions", "L1d misses", "LLC misses", "branch misses"};
+            return names[e];
+        }
+
+    private:
+        int Fds[NumEvents];
+
+#ifdef __linux__
+        static int open(std::uint32_t type, std::uint64_t config){
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+};
@@ -0,0 +1,256 @@
+#include "BenchUtils.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "RateSimulator.hpp"
+#include "ParallelFor.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+#include "SimulationWorkspace.hpp"
+#include "NumaTopology.hpp"
+#include "NumaPathEngine.hpp"
+#include "TiledSimulator.hpp"
+#include "TimeGrid.hpp"
+#include "ObservationSchedule.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+// Microbenchmarks of the simulation and pricing hot paths. Run with --filter to select
+// benchmarks by name and --reps / --warmup / --min-time to trade time for precision.
+// Hardware counters are reported where perf_event_open is permitted (--no-counters skips them)
+int main(int argc, char** argv){
+    BenchOptions options = BenchOptions::parse(argc, argv);
+    RateSimulator simulator;
+    const double initialRate = 0.03;
+    const double timeStep = 0.01;
+
+    printHeader();
+    // stepsPerItem > 0 adds a cycles-per-step figure to the hardware counter line
+    auto run = [&](const std::string& name, const std::string& unit, double items, double stepsPerItem, auto fn){
+        if (options.selected(name)){
+            BenchStats stats = runBenchmark(options, name, unit, items, fn);
+            stats.StepsPerItem = stepsPerItem;
+            printResult(stats);
+        }
+    };
+
+    // Single steps through the stateful model interface
+    {
+        VasicekModel vasicek(0.3, 0.05, 0.01);
+        CIRModel cir(0.3, 0.05, 0.05);
+        const unsigned int steps = 10000;
+        run("VasicekModel::simulateNextRate", "steps", steps, 1, [&]{
+            double r = initialRate;
+            for (unsigned int i = 0; i < steps; ++i) r = vasicek.simulateNextRate(r, timeStep);
+            doNotOptimize(r);
+        });
+        run("CIRModel::simulateNextRate", "steps", steps, 1, [&]{
+            double r = initialRate;
+            for (unsigned int i = 0; i < steps; ++i) r = cir.simulateNextRate(r, timeStep);
+            doNotOptimize(r);
+        });
+    }
+
+    // Whole paths through simulatePaths, across path lengths
+    for (unsigned int steps : {100u, 1000u}){
+        VasicekModel vasicek(0.3, 0.05, 0.01);
+        CIRModel cir(0.3, 0.05, 0.05);
+        const unsigned int paths = 100;
+        std::string suffix = "/steps=" + std::to_string(steps);
+        run("RateSimulator::simulatePaths/Vasicek" + suffix, "paths", paths, steps, [&]{
+            for (unsigned int p = 0; p < paths; ++p) doNotOptimize(simulator.simulatePaths(vasicek, initialRate, timeStep, steps).back());
+        });
+        run("RateSimulator::simulatePaths/CIR" + suffix, "paths", paths, steps, [&]{
+            for (unsigned int p = 0; p < paths; ++p) doNotOptimize(simulator.simulatePaths(cir, initialRate, timeStep, steps).back());
+        });
+    }
+
+    // Simulate-and-price calls, allocating a path each time versus reusing a workspace
+    {
+        VasicekModel vasicek(0.3, 0.05, 0.01);
+        Bond bond(1000, 10, 0.05, 0.5);
+        const unsigned int steps = 400;
+        const unsigned int prices = 100;
+        SimulationWorkspace workspace(steps);
+        run("RateSimulator::priceBond/allocating", "prices", prices, steps, [&]{
+            double sum = 0.0;
+            for (unsigned int p = 0; p < prices; ++p) sum += simulator.priceBond(bond, vasicek, initialRate, timeStep, steps);
+            doNotOptimize(sum);
+        });
+        run("RateSimulator::priceBond/workspace", "prices", prices, steps, [&]{
+            double sum = 0.0;
+            for (unsigned int p = 0; p < prices; ++p) sum += simulator.priceBond(bond, vasicek, initialRate, timeStep, steps, workspace);
+            doNotOptimize(sum);
+        });
+    }
+
+    // Simulating every step of a uniform grid versus only the bond's dates, refined to 0.25y
+    {
+        VasicekModel vasicek(0.3, 0.05, 0.01);
+        Bond bond(1000, 10, 0.05, 0.5);
+        const unsigned int prices = 100;
+        TimeGrid uniform = TimeGrid::uniform(0.025, 400);
+        TimeGrid events = TimeGrid::forInstruments({bond}, {}, 0.25);
+        for (const TimeGrid* grid : {&uniform, &events}){
+            std::string suffix = grid == &uniform ? "/uniform" : "/event-dates";
+            run("RateSimulator::priceBond/grid" + suffix, "prices", prices, grid->size(), [&]{
+                double sum = 0.0;
+                for (unsigned int p = 0; p < prices; ++p) sum += simulator.priceBond(bond, vasicek, initialRate, *grid);
+                doNotOptimize(sum);
+            });
+        }
+    }
+
+    // Storing every node of a fine grid versus only the bond and swaption dates (with integrals)
+    {
+        VasicekModel vasicek(0.3, 0.05, 0.01);
+        Bond bond(1000, 10, 0.05, 0.5);
+        Swaption swaption(0.05, 5, 1000, 5);
+        const unsigned int paths = 1024;
+        TimeGrid grid = TimeGrid::uniform(0.01, 1000);
+        ObservationSchedule schedule = ObservationSchedule::forInstruments(grid, {bond}, {swaption}, true);
+        std::vector<double> normals = simulator.generateNormals(paths, grid.size(), 3);
+        std::vector<double> full(normals.size());
+        std::vector<double> rates(paths * schedule.size()), integrals(rates.size());
+        std::fprintf(stderr, "Stored doubles per path: %zu full, %zu observed\n", grid.size(), 2 * schedule.size());
+        run("RateSimulator::simulatePathBlock/grid-full", "paths", paths, grid.size(), [&]{
+            simulator.simulatePathBlock(vasicek, initialRate, grid, normals.data(), paths, full.data());
+            doNotOptimize(full.back());
+        });
+        run("RateSimulator::simulateObserved", "paths", paths, grid.size(), [&]{
+            simulator.simulateObserved(vasicek, initialRate, grid, schedule, normals.data(), paths, rates.data(), integrals.data());
+            doNotOptimize(integrals.back());
+        });
+    }
+
+    // Path blocks from shared normals, across precisions and thread counts
+    {
+        CIRModel cir(0.3, 0.05, 0.05);
+        const unsigned int steps = 500;
+        const unsigned int paths = 8192;
+        const unsigned int blockSize = 256;
+        std::vector<double> normals = simulator.generateNormals(paths, steps, 1);
+        std::vector<float> normalsFloat = simulator.generateNormals<float>(paths, steps, 1);
+        std::vector<double> out(normals.size());
+        std::vector<float> outFloat(normals.size());
+
+        std::vector<unsigned int> threadCounts = {1, 2, 4};
+        unsigned int hardware = resolveThreadCount(0);
+        if (hardware > 4) threadCounts.push_back(hardware);
+        for (unsigned int threads : threadCounts){
+            std::string suffix = "/threads=" + std::to_string(threads);
+            run("RateSimulator::simulatePathBlock/double" + suffix, "paths", paths, steps, [&]{
+                parallelFor(paths / blockSize, threads, [&](std::size_t b, unsigned int){
+                    std::size_t offset = b * blockSize * steps;
+                    simulator.simulatePathBlock(cir, initialRate, timeStep, steps, normals.data() + offset, blockSize, out.data() + offset);
+                });
+            });
+            run("RateSimulator::simulatePathBlock/float" + suffix, "paths", paths, steps, [&]{
+                parallelFor(paths / blockSize, threads, [&](std::size_t b, unsigned int){
+                    std::size_t offset = b * blockSize * steps;
+                    simulator.simulatePathBlock(cir, initialRate, timeStep, steps, normalsFloat.data() + offset, blockSize, outFloat.data() + offset);
+                });
+            });
+        }
+    }
+
+    // NUMA engine on one node versus all nodes (one socket versus two on a dual-socket host)
+    {
+        NumaTopology topology = NumaTopology::detect();
+        CIRModel cir(0.3, 0.05, 0.05);
+        Bond bond(1000, 10, 0.05, 0.5);
+        std::vector<SwaptionTrade> swaptions = {{Swaption(0.05, 5, 1000, 5), 0.2, 4, true}};
+        const unsigned int steps = 500;
+        const unsigned int paths = 16384;
+        if (topology.numNodes() == 1){
+            std::fprintf(stderr, "Single NUMA node; only the one-node NUMA figure is measured\n");
+        }
+        for (std::size_t nodes = 1; nodes <= topology.numNodes(); ++nodes){
+            NumaPathEngine engine(topology.restrict(nodes));
+            std::string suffix = "/nodes=" + std::to_string(nodes) + "/cpus=" + std::to_string(topology.restrict(nodes).numCpus());
+            run("NumaPathEngine::simulate" + suffix, "paths", paths, steps, [&]{
+                engine.simulate(cir, initialRate, 0.02, steps, paths, 5);
+            });
+            run("NumaPathEngine::price" + suffix, "paths", paths, 0, [&]{
+                doNotOptimize(engine.price({bond}, swaptions)[0]);
+            });
+            if (engine.pinFailures() > 0){
+                std::fprintf(stderr, "%u workers could not be pinned\n", engine.pinFailures());
+            }
+        }
+    }
+
+    // Stored path-major paths versus tiles that accumulate payoffs in cache, across tile sizes
+    {
+        CIRModel cir(0.3, 0.05, 0.05);
+        std::vector<Bond> bonds = {Bond(1000, 10, 0.05, 0.5)};
+        std::vector<SwaptionTrade> swaptions = {{Swaption(0.05, 5, 1000, 5), 0.2, 4, true}};
+        const unsigned int steps = 500;
+        const unsigned int paths = 16384;
+        NumaPathEngine engine(NumaTopology::detect());
+        run("PathMajor::simulate+price", "paths", paths, steps, [&]{
+            engine.simulate(cir, initialRate, 0.02, steps, paths, 5);
+            doNotOptimize(engine.price(bonds, swaptions)[0]);
+        });
+
+        TiledSimulator tiled(paths, 0.02, steps, 5);
+        TileShape automatic = tiled.tile();
+        std::fprintf(stderr, "L2 %zu bytes, auto tile %u paths x %u steps\n",
+                     TiledSimulator::l2CacheBytes(), automatic.Paths, automatic.Steps);
+        std::vector<TileShape> shapes = {automatic, {64, 64}, {256, 64}, {1024, 64}, {4096, 16}, {256, steps}};
+        for (const TileShape& shape : shapes){
+            tiled.setTile(shape);
+            std::string suffix = "/tile=" + std::to_string(tiled.tile().Paths) + "x" + std::to_string(tiled.tile().Steps);
+            run("TiledSimulator::price" + suffix, "paths", paths, steps, [&]{
+                doNotOptimize(tiled.price(cir, initialRate, bonds, swaptions)[0]);
+            });
+        }
+    }
+
+    // Pricing off stored paths: the vector interface, compiled schedules, and float paths
+    for (unsigned int steps : {400u, 2000u}){
+        VasicekModel vasicek(0.3, 0.05, 0.01);
+        const unsigned int paths = 256;
+        double pricingStep = 20.0 / steps;
+        std::vector<double> normals = simulator.generateNormals(paths, steps, 2);
+        std::vector<double> rates = simulator.simulatePathBlock(vasicek, initialRate, pricingStep, steps, normals);
+        std::vector<float> ratesFloat(rates.begin(), rates.end());
+        std::vector<std::vector<double>> pathVectors;
+        for (unsigned int p = 0; p < paths; ++p){
+            pathVectors.emplace_back(rates.begin() + p * steps, rates.begin() + (p + 1) * steps);
+        }
+
+        Bond bond(1000, 10, 0.05, 0.5);
+        Swaption swaption(0.05, 10, 1000, 1);
+        std::vector<CashFlow> schedule = bond.cashFlowSchedule(pricingStep, steps);
+        std::string suffix = "/steps=" + std::to_string(steps);
+
+        run("Bond::price/vector" + suffix, "prices", paths, 0, [&]{
+            double sum = 0.0;
+            for (const std::vector<double>& path : pathVectors) sum += bond.price(path, pricingStep);
+            doNotOptimize(sum);
+        });
+        run("Bond::price/schedule" + suffix, "prices", paths, 0, [&]{
+            double sum = 0.0;
+            for (unsigned int p = 0; p < paths; ++p) sum += Bond::price(rates.data() + p * steps, schedule);
+            doNotOptimize(sum);
+        });
+        run("Bond::price/schedule-float" + suffix, "prices", paths, 0, [&]{
+            double sum = 0.0;
+            for (unsigned int p = 0; p < paths; ++p) sum += Bond::price(ratesFloat.data() + p * steps, schedule);
+            doNotOptimize(sum);
+        });
+        run("Swaption::price/vector" + suffix, "prices", paths, 0, [&]{
+            double sum = 0.0;
+            for (const std::vector<double>& path : pathVectors) sum += swaption.price(path, 0.2, pricingStep, 4, true);
+            doNotOptimize(sum);
+        });
+        run("Swaption::price/float" + suffix, "prices", paths, 0, [&]{
+            double sum = 0.0;
+            for (unsigned int p = 0; p < paths; ++p) sum += swaption.price(ratesFloat.data() + p * steps, steps, 0.2, pricingStep, 4, true);
+            doNotOptimize(sum);
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include "BenchUtils.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "RateSimulator.hpp"
+#include "ParallelFor.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+
+#include <sys/resource.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Performance regression harness. Runs a fixed matrix of end-to-end workloads (simulate a
+// path block, then price an instrument mix on every path), writes the results as JSON and,
+// given a baseline file, flags workloads whose throughput dropped by more than the noise
+//
+//   bench_regression [--output FILE] [--baseline FILE] [--tolerance FRACTION] [--reps N]
+//
+// Exit status is 1 when a regression is found, so the harness can gate a build
+
+namespace {
+
+struct Workload{
+    std::string Name;
+    std::string Model;
+    unsigned int Paths;
+    std::string Mix;
+};
+
+struct WorkloadResult{
+    std::string Name;
+    double Throughput;
+    double MAD;
+    double P50;
+    double P90;
+    double P99;
+    long PeakRssKb;  // process high-water mark after the workload
+};
+
+const unsigned int Steps = 250;
+const double TimeStep = 0.04;
+const double InitialRate = 0.03;
+const unsigned int BlockSize = 256;
+
+long peakRssKb(){
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+std::vector<Workload> workloadMatrix(){
+    std::vector<Workload> workloads;
+    for (const char* model : {"vasicek", "cir"}){
+        for (unsigned int paths : {1000u, 10000u}){
+            for (const char* mix : {"bonds", "swaptions", "mixed"}){
+                std::string name = std::string(model) + "/paths=" + std::to_string(paths) + "/" + mix;
+                workloads.push_back({name, model, paths, mix});
+            }
+        }
+    }
+    return workloads;
+}
+
+// Simulate and price one workload; returns the summed prices so the work is observable
+double runWorkload(const Workload& workload, const InterestRateModel& model, const std::vector<double>& normals,
+                   std::vector<double>& rates, const std::vector<std::vector<CashFlow>>& schedules, const std::vector<Swaption>& swaptions){
+    RateSimulator simulator;
+    bool priceBonds = workload.Mix != "swaptions";
+    bool priceSwaptions = workload.Mix != "bonds";
+    std::size_t blocks = (workload.Paths + BlockSize - 1) / BlockSize;
+    std::vector<double> partial(blocks, 0.0);
+
+    parallelFor(blocks, 0, [&](std::size_t b, unsigned int){
+        unsigned int first = b * BlockSize;
+        unsigned int count = std::min(BlockSize, workload.Paths - first);
+        std::size_t offset = static_cast<std::size_t>(first) * Steps;
+        simulator.simulatePathBlock(model, InitialRate, TimeStep, Steps, normals.data() + offset, count, rates.data() + offset);
+
+        double sum = 0.0;
+        for (unsigned int p = 0; p < count; ++p){
+            const double* path = rates.data() + offset + static_cast<std::size_t>(p) * Steps;
+            if (priceBonds){
+                for (const std::vector<CashFlow>& schedule : schedules) sum += Bond::price(path, schedule);
+            }
+            if (priceSwaptions){
+                for (const Swaption& swaption : swaptions) sum += swaption.price(path, Steps, 0.2, TimeStep, 4, true);
+            }
+        }
+        partial[b] = sum;
+    });
+
+    double total = 0.0;
+    for (double value : partial) total += value;
+    return total;
+}
+
+WorkloadResult measure(const Workload& workload, const BenchOptions& options){
+    VasicekModel vasicek(0.3, 0.05, 0.01);
+    CIRModel cir(0.3, 0.05, 0.05);
+    const InterestRateModel& model = workload.Model == "cir" ? static_cast<const InterestRateModel&>(cir) : vasicek;
+
+    RateSimulator simulator;
+    std::vector<double> normals = simulator.generateNormals(workload.Paths, Steps, 42);
+    std::vector<double> rates(normals.size());
+
+    std::vector<Bond> bonds = {Bond(1000, 2, 0.03, 1), Bond(1000, 5, 0.04, 0.5), Bond(1000, 9, 0.05, 0.5)};
+    std::vector<std::vector<CashFlow>> schedules;
+    for (const Bond& bond : bonds) schedules.push_back(bond.cashFlowSchedule(TimeStep, Steps));
+    std::vector<Swaption> swaptions = {Swaption(0.04, 2, 1000, 3), Swaption(0.05, 5, 1000, 5)};
+
+    // Each repetition is one end-to-end run; its wall time is the latency sample
+    BenchStats stats = runBenchmark(options, workload.Name, "paths", workload.Paths, [&]{
+        doNotOptimize(runWorkload(workload, model, normals, rates, schedules, swaptions));
+    });
+
+    WorkloadResult result;
+    result.Name = workload.Name;
+    result.Throughput = stats.throughput();
+    result.MAD = stats.Median > 0.0 ? stats.ItemsPerCall / stats.Median * stats.MAD / stats.Median : 0.0;
+    result.P50 = percentile(stats.Samples, 50);
+    result.P90 = percentile(stats.Samples, 90);
+    result.P99 = percentile(stats.Samples, 99);
+    result.PeakRssKb = peakRssKb();
+    return result;
+}
+
+// One workload per line so the baseline can be read back without a JSON library
+bool writeJson(const std::string& filename, const std::vector<WorkloadResult>& results){
+    std::ofstream out(filename);
+    if (!out){
+        std::cerr << "Could not open " << filename << " for writing" << std::endl;
+        return false;
+    }
+    out << "{\n  \"steps\": " << Steps << ",\n  \"workloads\": [\n";
+    char line[512];
+    for (std::size_t i = 0; i < results.size(); ++i){
+        const WorkloadResult& r = results[i];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"throughput\": %.6g, \"mad\": %.6g, \"p50\": %.6g, \"p90\": %.6g, \"p99\": %.6g, \"peak_rss_kb\": %ld}%s\n",
+                      r.Name.c_str(), r.Throughput, r.MAD, r.P50, r.P90, r.P99, r.PeakRssKb,
+                      i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return true;
+}
+
+double numberField(const std::string& line, const std::string& key){
+    std::size_t pos = line.find("\"" + key + "\":");
+    if (pos == std::string::npos) return 0.0;
+    return std::atof(line.c_str() + pos + key.size() + 3);
+}
+
+// Read a file produced by writeJson: name -> result
+std::map<std::string, WorkloadResult> readBaseline(const std::string& filename){
+    std::map<std::string, WorkloadResult> baseline;
+    std::ifstream in(filename);
+    if (!in){
+        std::cerr << "Could not open baseline " << filename << std::endl;
+        return baseline;
+    }
+    std::string line;
+    while (std::getline(in, line)){
+        std::size_t pos = line.find("\"name\": \"");
+        if (pos == std::string::npos) continue;
+        pos += 9;
+        WorkloadResult r;
+        r.Name = line.substr(pos, line.find('"', pos) - pos);
+        r.Throughput = numberField(line, "throughput");
+        r.MAD = numberField(line, "mad");
+        r.P50 = numberField(line, "p50");
+        r.P90 = numberField(line, "p90");
+        r.P99 = numberField(line, "p99");
+        r.PeakRssKb = static_cast<long>(numberField(line, "peak_rss_kb"));
+        baseline[r.Name] = r;
+    }
+    return baseline;
+}
+
+// A workload regresses when throughput falls by more than the larger of the tolerance and
+// three times the combined relative MAD of the two runs
+int compare(const std::vector<WorkloadResult>& results, const std::map<std::string, WorkloadResult>& baseline,
+            double tolerance){
+    int regressions = 0;
+    std::printf("\n%-36s %12s %12s %9s %9s  %s\n", "workload", "baseline", "current", "change", "allowed", "verdict");
+    for (const WorkloadResult& r : results){
+        auto it = baseline.find(r.Name);
+        if (it == baseline.end() || it->second.Throughput <= 0.0){
+            std::printf("%-36s %12s %12.4g %9s %9s  new\n", r.Name.c_str(), "-", r.Throughput, "-", "-");
+            continue;
+        }
+        const WorkloadResult& base = it->second;
+        double noise = base.MAD / base.Throughput + (r.Throughput > 0.0 ? r.MAD / r.Throughput : 0.0);
+        double allowed = std::max(tolerance, 3.0 * noise);
+        double change = r.Throughput / base.Throughput - 1.0;
+        const char* verdict = "ok";
+        if (change < -allowed){
+            verdict = "REGRESSION";
+            ++regressions;
+        }
+        else if (change > allowed){
+            verdict = "improved";
+        }
+        std::printf("%-36s %12.4g %12.4g %8.1f%% %8.1f%%  %s\n", r.Name.c_str(), base.Throughput, r.Throughput,
+                    100.0 * change, 100.0 * allowed, verdict);
+    }
+    return regressions;
+}
+
+}
+
+int main(int argc, char** argv){
+    std::string output = "bench_results.json";
+    std::string baselineFile;
+    double tolerance = 0.1;
+
+    // Strip the harness options and hand the rest to BenchOptions
+    std::vector<char*> rest = {argv[0]};
+    for (int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) output = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc) baselineFile = argv[++i];
+        else if (arg == "--tolerance" && i + 1 < argc) tolerance = std::atof(argv[++i]);
+        else rest.push_back(argv[i]);
+    }
+    BenchOptions options = BenchOptions::parse(static_cast<int>(rest.size()), rest.data());
+    options.MinSampleSeconds = 0.0;
+    options.Counters = false;
+
+    std::vector<WorkloadResult> results;
+    for (const Workload& workload : workloadMatrix()){
+        if (!options.selected(workload.Name)) continue;
+        WorkloadResult result = measure(workload, options);
+        std::printf("%-36s %10.4g paths/s  p50 %8.3f ms  p90 %8.3f ms  p99 %8.3f ms  rss %ld KB\n",
+                    result.Name.c_str(), result.Throughput, result.P50 * 1e3, result.P90 * 1e3, result.P99 * 1e3,
+                    result.PeakRssKb);
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+
+    if (!writeJson(output, results)) return 1;
+    std::cout << "Results written to " << output << std::endl;
+
+    if (baselineFile.empty()) return 0;
+    std::map<std::string, WorkloadResult> baseline = readBaseline(baselineFile);
+    if (baseline.empty()) return 1;
+    int regressions = compare(results, baseline, tolerance);
+    std::cout << regressions << " regression(s) against " << baselineFile << std::endl;
+    return regressions > 0 ? 1 : 0;
+}
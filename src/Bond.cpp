@@ -1,4 +1,6 @@
 #include "Bond.hpp"
+#include "TimeGrid.hpp"
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <iostream>
@@ -6,34 +8,62 @@
 // Constructor for Bond class
 Bond::Bond(double FV, double Mat, double CR, double f) : FaceValue(FV), Maturity(Mat), couponRate(CR), Frequency(f) {}
 
-// Calculate the bond price
-double Bond::price(const std::vector<double>& rates, double timeStep) const {
+// Calculate bond price off a yield curve
+double Bond::price(const YieldCurve& curve) const {
+    std::vector<CashFlow> flows = cashFlows();
+    std::vector<double> times;
+    for (const CashFlow& cf : flows) {
+        times.push_back(cf.Time);
+    }
+    std::vector<double> dfs = curve.discountFactors(times);
+
     double presentValue = 0.0;
+    for (std::size_t i = 0; i < flows.size(); ++i) {
+        presentValue += flows[i].Amount * dfs[i];
+    }
+    return presentValue;
+}
+
+// Coupon and principal cash flows
+std::vector<CashFlow> Bond::cashFlows() const {
+    std::vector<CashFlow> flows;
     double cashFlow = FaceValue * couponRate * Frequency;
     int couponPeriods = static_cast<int>(Maturity / Frequency);
-    int maxIndex = rates.size() - 1; // Maximum valid index for rates vector
 
     for (int i = 0; i < couponPeriods; ++i) {
-        double time = (i + 1) * Frequency;
-        int rateIndex = static_cast<int>(time / timeStep);
+        flows.push_back({-1, (i + 1) * Frequency, cashFlow});
+    }
+    flows.push_back({-1, Maturity, FaceValue});
 
-        // Use the last available rate if rateIndex is out of bounds
-        if (rateIndex > maxIndex) {
-            rateIndex = maxIndex; 
-        }
+    return flows;
+}
+
+// Compile the cash flows against a simulation grid
+std::vector<CashFlow> Bond::cashFlowSchedule(double timeStep, unsigned int numRates) const {
+    std::vector<CashFlow> schedule = cashFlows();
+    int maxIndex = static_cast<int>(numRates) - 1;
 
-        presentValue += cashFlow * std::exp(-rates[rateIndex] * time);
+    // Same index mapping as price(), clamped to the last available rate
+    for (CashFlow& cf : schedule) {
+        cf.RateIndex = std::min(static_cast<int>(cf.Time / timeStep), maxIndex);
     }
 
-    // Add present value of face value at maturity
-    double maturityTime = Maturity;
-    int maturityIndex = static_cast<int>(maturityTime / timeStep);
+    return schedule;
+}
 
-    if (maturityIndex > maxIndex) {
-        maturityIndex = maxIndex; // Use the last available rate if maturityIndex is out of bounds
-    }
+// Compile the cash flows against exact grid nodes
+std::vector<CashFlow> Bond::cashFlowSchedule(const TimeGrid& grid) const {
+    std::vector<CashFlow> schedule = cashFlows();
+    const std::vector<double>& times = grid.times();
 
-    presentValue += FaceValue * std::exp(-rates[maturityIndex] * maturityTime);
+    for (CashFlow& cf : schedule) {
+        cf.RateIndex = grid.index(cf.Time);
+        if (cf.RateIndex < 0) {
+            std::cerr << "Error: Cash flow at " << cf.Time << " is not a node of the time grid." << std::endl;
+            std::size_t next = std::lower_bound(times.begin(), times.end(), cf.Time) - times.begin();
+            cf.RateIndex = static_cast<int>(std::min(next, times.size() - 1));
+        }
+    }
 
-    return presentValue;
-}
\ No newline at end of file
+    return schedule;
+}
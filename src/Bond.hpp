@@ -1,6 +1,19 @@
 #pragma once
 
+#include <cmath>
 #include <vector>
+#include "YieldCurve.hpp"
+#include "Precision.hpp"
+#include "Instrumentation.hpp"
+
+class TimeGrid;
+
+// Bond cash flow; RateIndex is only set once compiled against a simulation grid
+struct CashFlow{
+    int RateIndex;
+    double Time;
+    double Amount;
+};
 
 // Class for bonds
 class Bond{
@@ -15,7 +28,75 @@ class Bond{
         // Constructor for Bond class        
         Bond(double FV, double Mat, double CR, double f);
 
-        // Calculate bond price
-        double price(const std::vector<double>& rates, double timeStep) const;
+        // Calculate bond price, templated on the scalar type of the rates
+        // (double or float paths, or a Dual for pathwise sensitivities)
+        template<typename T>
+        Accumulator<T> price(const std::vector<T>& rates, double timeStep) const;
+
+        // Calculate bond price by discounting off a yield curve
+        double price(const YieldCurve& curve) const;
+
+        // Coupon and principal cash flows (RateIndex = -1)
+        std::vector<CashFlow> cashFlows() const;
+
+        // Compile the cash flows against a grid of numRates rates spaced timeStep apart,
+        // so repeated pricing skips the index arithmetic
+        std::vector<CashFlow> cashFlowSchedule(double timeStep, unsigned int numRates) const;
+
+        // Compile the cash flows against the nodes of a time grid, matching each flow to the
+        // node at its date; a date that is not a node is reported and takes the next node
+        std::vector<CashFlow> cashFlowSchedule(const TimeGrid& grid) const;
+
+        // Price a path of rates against a compiled schedule
+        template<typename T>
+        static Accumulator<T> price(const T* rates, const std::vector<CashFlow>& schedule);
 };
 
+// Calculate the bond price
+template<typename T>
+Accumulator<T> Bond::price(const std::vector<T>& rates, double timeStep) const {
+    using std::exp;
+    IR_PROFILE_SCOPE(Payoff);
+
+    Accumulator<T> presentValue = 0.0;
+    double cashFlow = FaceValue * couponRate * Frequency;
+    int couponPeriods = static_cast<int>(Maturity / Frequency);
+    int maxIndex = rates.size() - 1; // Maximum valid index for rates vector
+
+    for (int i = 0; i < couponPeriods; ++i) {
+        double time = (i + 1) * Frequency;
+        int rateIndex = static_cast<int>(time / timeStep);
+
+        // Use the last available rate if rateIndex is out of bounds
+        if (rateIndex > maxIndex) {
+            rateIndex = maxIndex; 
+        }
+
+        presentValue += cashFlow * exp(-rates[rateIndex] * time);
+    }
+
+    // Add present value of face value at maturity
+    double maturityTime = Maturity;
+    int maturityIndex = static_cast<int>(maturityTime / timeStep);
+
+    if (maturityIndex > maxIndex) {
+        maturityIndex = maxIndex; // Use the last available rate if maturityIndex is out of bounds
+    }
+
+    presentValue += FaceValue * exp(-rates[maturityIndex] * maturityTime);
+
+    return presentValue;
+}
+
+// Price a path of rates against a compiled schedule
+template<typename T>
+Accumulator<T> Bond::price(const T* rates, const std::vector<CashFlow>& schedule) {
+    using std::exp;
+    IR_PROFILE_SCOPE(Payoff);
+
+    Accumulator<T> presentValue = 0.0;
+    for (const CashFlow& cf : schedule) {
+        presentValue += cf.Amount * exp(-rates[cf.RateIndex] * cf.Time);
+    }
+    return presentValue;
+}
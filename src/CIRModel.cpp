@@ -1,4 +1,5 @@
 #include "CIRModel.hpp"
+#include "Instrumentation.hpp"
 #include <iostream>
 #include <vector>
 #include <fstream>
@@ -20,13 +21,10 @@ double CIRModel::simulateNextRate(double currentRate, double timeStep){
     // Generate normal random variable
     double dw = distribution(generator);
 
-    // Calculate next rate using CIR model, ensuring non-negative rates
-    double sqrtRate = std::sqrt(std::max(currentRate, 0.0));
-    double nextRate = currentRate + MeanReversion * (LongTermMean - currentRate) * timeStep 
-                      + Volatility * sqrtRate * std::sqrt(timeStep) * dw;
+    double nextRate = step(currentRate, MeanReversion, LongTermMean, Volatility, timeStep, dw);
 
-    // Ensure the next rate is non-negative
-    nextRate = std::max(nextRate, 0.0);
-    
+    // A zero result means the Euler step went negative and was truncated
+    IR_COUNT(Steps, 1);
+    IR_COUNT(RejectedSamples, nextRate == 0.0);
     return nextRate;
-}
\ No newline at end of file
+}
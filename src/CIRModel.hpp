@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include "InterestRateModel.hpp"
 
 // Class to implement CIR model
@@ -13,5 +14,66 @@ class CIRModel : public InterestRateModel{
 
         // Simulate next interest rate using CIR model
         double simulateNextRate(double currentRate, double timeStep);
-};
 
+        // Advance a rate given the normal draw (time-homogeneous, so time is unused)
+        double nextRate(double currentRate, double, double timeStep, double dw) const{
+            return step(currentRate, MeanReversion, LongTermMean, Volatility, timeStep, dw);
+        }
+
+        // Affine zero-coupon bond price P = A exp(-B r) for a bond with tau years left,
+        // templated on the scalar type so Dual parameters give exact Jacobians
+        template<typename T>
+        static T zeroCouponBond(const T& meanRev, const T& ltm, const T& vol, double rate, double tau){
+            using std::exp;
+            using std::log1p;
+            using std::sqrt;
+            T gamma = sqrt(meanRev * meanRev + 2.0 * vol * vol);
+            T expGamma = exp(gamma * tau) - 1.0;
+            T B = 2.0 * expGamma / ((gamma + meanRev) * expGamma + 2.0 * gamma);
+
+            // log A written with gamma - a = 2 sigma^2 / (gamma + a) so every term is O(sigma^2)
+            // and the 2ab / sigma^2 prefactor does not amplify cancellation for small sigma
+            T sum = gamma + meanRev;
+            T k = 2.0 * vol * vol / (sum * sum);
+            T logRatio = log1p(k) - vol * vol * tau / sum - log1p(k * exp(-gamma * tau));
+            T logA = 2.0 * meanRev * ltm / (vol * vol) * logRatio;
+            return exp(logA - B * rate);
+        }
+
+        double zeroCouponBondPrice(double rate, double time, double maturity) const{
+            return zeroCouponBond(MeanReversion, LongTermMean, Volatility, rate, maturity - time);
+        }
+
+        double diffusion(double rate, double) const { return Volatility * std::sqrt(std::max(rate, 0.0)); }
+
+        // Lattice in x = sqrt(r), which has constant volatility sigma / 2 by Ito's lemma
+        double latticeState(double rate) const { return std::sqrt(std::max(rate, 0.0)); }
+        double latticeRate(double state) const { return state * state; }
+        double latticeDrift(double state, double) const{
+            // The drift is singular at x = 0; evaluate it just above the boundary
+            double x = std::max(state, 1e-4);
+            return (4.0 * MeanReversion * LongTermMean - Volatility * Volatility) / (8.0 * x) - 0.5 * MeanReversion * x;
+        }
+        double latticeVolatility() const { return 0.5 * Volatility; }
+
+        std::unique_ptr<InterestRateModel> clone() const{
+            return std::make_unique<CIRModel>(*this);
+        }
+
+        // Advance a rate by one step given a standard normal draw dw, templated on
+        // the scalar type so parameters can carry tangents for pathwise Greeks; with
+        // T = S = float the whole step runs in single precision
+        template<typename T, typename S = double>
+        static T step(const T& currentRate, const T& meanRev, const T& ltm, const T& vol,
+                      S timeStep, S dw){
+            using std::sqrt;
+
+            // Calculate next rate using CIR model, ensuring non-negative rates
+            T sqrtRate = currentRate > 0.0 ? sqrt(currentRate) : T(0.0);
+            T nextRate = currentRate + meanRev * (ltm - currentRate) * timeStep
+                            + vol * sqrtRate * std::sqrt(timeStep) * dw;
+
+            // Ensure the next rate is non-negative
+            return nextRate > 0.0 ? nextRate : T(0.0);
+        }
+};
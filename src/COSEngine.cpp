@@ -0,0 +1,252 @@
+#include "COSEngine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+
+namespace {
+    const double Pi = 3.14159265358979323846;
+
+    // Lanes of the cos/sin recurrence: lane j handles terms k = j, j + Lanes, ...
+    const unsigned int Lanes = 8;
+}
+
+// Constructor for COSEngine class
+COSEngine::COSEngine(unsigned int terms, double truncation)
+    : Terms(std::max(terms, Lanes)), Truncation(truncation) {}
+
+// Vasicek: (int r, r_T) is jointly Gaussian
+COSEngine::Expansion COSEngine::expansion(const VasicekModel& model, double InitialRate, double expiry) const{
+    double a = model.getMeanReversion();
+    double b = model.getLongTermMean();
+    double s = model.getVolatility();
+    double T = expiry;
+
+    double decay = std::exp(-a * T);
+    double B = (1.0 - decay) / a;
+    double meanR = InitialRate * decay + b * (1.0 - decay);
+    double varR = s * s * (1.0 - decay * decay) / (2.0 * a);
+    double meanI = b * T + (InitialRate - b) * B;
+    double varI = s * s / (a * a) * (T - 2.0 * B + (1.0 - decay * decay) / (2.0 * a));
+    double cov = s * s / (2.0 * a * a) * (1.0 - decay) * (1.0 - decay);
+
+    double width = Truncation * std::sqrt(varR);
+    double lower = meanR - width;
+    double upper = meanR + width;
+
+    // log phi(u) = -meanI + varI / 2 - u^2 varR / 2 + i u (meanR - cov)
+    std::vector<double> phiRe(Terms), phiIm(Terms);
+    double du = Pi / (upper - lower);
+    for (unsigned int k = 0; k < Terms; ++k){
+        double u = k * du;
+        double magnitude = std::exp(-meanI + 0.5 * varI - 0.5 * u * u * varR);
+        double angle = u * (meanR - cov);
+        phiRe[k] = magnitude * std::cos(angle);
+        phiIm[k] = magnitude * std::sin(angle);
+    }
+    return finish(phiRe, phiIm, lower, upper);
+}
+
+// CIR: closed-form solution of the Riccati equations with beta(0) = i u
+COSEngine::Expansion COSEngine::expansion(const CIRModel& model, double InitialRate, double expiry) const{
+    typedef std::complex<double> Complex;
+    double a = model.getMeanReversion();
+    double b = model.getLongTermMean();
+    double s = model.getVolatility();
+    double T = expiry;
+
+    double decay = std::exp(-a * T);
+    double meanR = InitialRate * decay + b * (1.0 - decay);
+    double varR = InitialRate * s * s / a * (decay - decay * decay) + b * s * s / (2.0 * a) * (1.0 - decay) * (1.0 - decay);
+    double width = Truncation * std::sqrt(varR);
+    double lower = std::max(0.0, meanR - width);
+    double upper = meanR + width;
+
+    // beta' = s^2 beta^2 / 2 - a beta - 1 has roots xPlus > 0 > xMinus. Writing the solution
+    // with D = (z - xMinus) / (z - xPlus), |D| < 1, keeps the logarithm on its principal branch
+    double gamma = std::sqrt(a * a + 2.0 * s * s);
+    double xPlus = (a + gamma) / (s * s);
+    double xMinus = (a - gamma) / (s * s);
+    double damp = std::exp(-gamma * T);
+
+    std::vector<double> phiRe(Terms), phiIm(Terms);
+    double du = Pi / (upper - lower);
+    for (unsigned int k = 0; k < Terms; ++k){
+        Complex z(0.0, k * du);
+        Complex D = (z - xMinus) / (z - xPlus);
+        Complex denominator = 1.0 - D * damp;
+        Complex beta = xMinus - (xPlus - xMinus) * D * damp / denominator;
+        Complex alpha = a * b * (xMinus * T - 2.0 / (s * s) * std::log(denominator / (1.0 - D)));
+        Complex phi = std::exp(alpha + beta * InitialRate);
+        phiRe[k] = phi.real();
+        phiIm[k] = phi.imag();
+    }
+    return finish(phiRe, phiIm, lower, upper);
+}
+
+// Cosine coefficients 2 / (upper - lower) Re[phi(u_k) e^{-i u_k lower}]
+COSEngine::Expansion COSEngine::finish(const std::vector<double>& phiRe, const std::vector<double>& phiIm,
+                                       double lower, double upper) const{
+    Expansion density;
+    density.Lower = lower;
+    density.Upper = upper;
+    density.Coefficients.resize(Terms);
+
+    double du = Pi / (upper - lower);
+    double scale = 2.0 / (upper - lower);
+    for (unsigned int k = 0; k < Terms; ++k){
+        double angle = k * du * lower;
+        density.Coefficients[k] = scale * (phiRe[k] * std::cos(angle) + phiIm[k] * std::sin(angle));
+    }
+    density.Coefficients[0] *= 0.5;
+    return density;
+}
+
+// Options on exp(logA - B r) given the expansion of the discounted density
+std::vector<double> COSEngine::bondOptions(const Expansion& density, double logA, double B,
+                                           const std::vector<double>& strikes, bool isCall) const{
+    const double lower = density.Lower;
+    const double upper = density.Upper;
+    const double width = upper - lower;
+    const double du = Pi / width;
+    const double* coefficients = density.Coefficients.data();
+
+    // Terms the payoff integrals share across strikes
+    std::vector<double> u(Terms), inverseNorm(Terms);
+    for (unsigned int k = 0; k < Terms; ++k){
+        u[k] = k * du;
+        inverseNorm[k] = 1.0 / (B * B + u[k] * u[k]);
+    }
+
+    std::vector<double> prices(strikes.size(), 0.0);
+    double cosLane[Lanes], sinLane[Lanes];
+    for (std::size_t s = 0; s < strikes.size(); ++s){
+        double K = strikes[s];
+        if (K <= 0.0){
+            // Always exercised: the call is the discounted bond, the put is worthless
+            if (isCall){
+                double value = 0.0;
+                for (unsigned int k = 0; k < Terms; ++k){
+                    double sign = (k & 1) ? -1.0 : 1.0;
+                    double bond = B * (std::exp(logA - B * lower) - sign * std::exp(logA - B * upper)) * inverseNorm[k];
+                    value += coefficients[k] * bond;
+                }
+                prices[s] = value;
+            }
+            continue;
+        }
+
+        // The bond exceeds the strike below rStar
+        double rStar = (logA - std::log(K)) / B;
+        double edge = std::min(std::max(rStar, lower), upper);
+        double bondAtEdge = std::exp(logA - B * edge);
+
+        // cos(u_k (edge - lower)) and sin(...) by rotation, Lanes independent chains
+        double theta = du * (edge - lower);
+        for (unsigned int j = 0; j < Lanes; ++j){
+            cosLane[j] = std::cos(j * theta);
+            sinLane[j] = std::sin(j * theta);
+        }
+        double cosStep = std::cos(Lanes * theta);
+        double sinStep = std::sin(Lanes * theta);
+
+        // Integral over [lower, edge] (call) or [edge, upper] (put) of (bond - K) cos(u_k (r - lower)):
+        //   int e^{-B r} cos = e^{-B r} (u sin - B cos) / (B^2 + u^2),  int cos = sin / u
+        double bondLower = std::exp(logA - B * lower);
+        double bondUpper = std::exp(logA - B * upper);
+        double value = 0.0;
+        for (unsigned int k0 = 0; k0 < Terms; k0 += Lanes){
+            for (unsigned int j = 0; j < Lanes && k0 + j < Terms; ++j){
+                unsigned int k = k0 + j;
+                double c = cosLane[j];
+                double sn = sinLane[j];
+                double sign = (k & 1) ? -1.0 : 1.0;
+
+                double bondEdge = bondAtEdge * (u[k] * sn - B * c) * inverseNorm[k];
+                double cashEdge = k == 0 ? edge : sn / u[k];
+                double term;
+                if (isCall){
+                    double bondPart = bondEdge - bondLower * (-B) * inverseNorm[k];
+                    double cashPart = k == 0 ? edge - lower : cashEdge;
+                    term = bondPart - K * cashPart;
+                } else{
+                    double bondPart = bondUpper * (-B * sign) * inverseNorm[k] - bondEdge;
+                    double cashPart = k == 0 ? upper - edge : -cashEdge;
+                    term = K * cashPart - bondPart;
+                }
+                value += coefficients[k] * term;
+
+                // Advance this lane by Lanes terms
+                cosLane[j] = c * cosStep - sn * sinStep;
+                sinLane[j] = sn * cosStep + c * sinStep;
+            }
+        }
+        prices[s] = std::max(value, 0.0);
+    }
+    return prices;
+}
+
+// Zero-coupon bond options for either model
+template<typename Model>
+std::vector<double> COSEngine::zeroCouponBondOptionsImpl(const Model& model, double InitialRate, double expiry, double maturity,
+                                                         const std::vector<double>& strikes, bool isCall) const{
+    if (expiry <= 0 || maturity <= expiry){
+        std::cerr << "Option expiry must be positive and before the bond's maturity." << std::endl;
+        return std::vector<double>(strikes.size(), 0.0);
+    }
+    Expansion density = expansion(model, InitialRate, expiry);
+
+    // The bond at expiry is exp(logA - B r) in both affine models
+    double logA = std::log(model.zeroCouponBondPrice(0.0, expiry, maturity));
+    double B = (logA - std::log(model.zeroCouponBondPrice(0.1, expiry, maturity))) / 0.1;
+    return bondOptions(density, logA, B, strikes, isCall);
+}
+
+// Caps and floors for either model
+template<typename Model>
+std::vector<double> COSEngine::capFloorsImpl(const Model& model, double InitialRate, double maturity, double frequency,
+                                             const std::vector<double>& strikes, double notional, bool isCap) const{
+    std::vector<double> prices(strikes.size(), 0.0);
+    if (frequency <= 0){
+        std::cerr << "Payment frequency must be positive." << std::endl;
+        return prices;
+    }
+
+    // A caplet on [T, T + delta] struck at K pays like (1 + delta K) puts on P(T, T + delta)
+    // struck at 1 / (1 + delta K); a floorlet is the matching call
+    double delta = 1.0 / frequency;
+    int periods = static_cast<int>(std::lround(maturity * frequency));
+    std::vector<double> bondStrikes(strikes.size());
+    for (std::size_t s = 0; s < strikes.size(); ++s){
+        bondStrikes[s] = 1.0 / (1.0 + delta * strikes[s]);
+    }
+
+    for (int p = 1; p < periods; ++p){
+        double reset = p * delta;
+        std::vector<double> options = zeroCouponBondOptionsImpl(model, InitialRate, reset, reset + delta, bondStrikes, !isCap);
+        for (std::size_t s = 0; s < strikes.size(); ++s){
+            prices[s] += notional * (1.0 + delta * strikes[s]) * options[s];
+        }
+    }
+    return prices;
+}
+
+std::vector<double> COSEngine::zeroCouponBondOptions(const VasicekModel& model, double InitialRate, double expiry, double maturity,
+                                                     const std::vector<double>& strikes, bool isCall) const{
+    return zeroCouponBondOptionsImpl(model, InitialRate, expiry, maturity, strikes, isCall);
+}
+
+std::vector<double> COSEngine::zeroCouponBondOptions(const CIRModel& model, double InitialRate, double expiry, double maturity,
+                                                     const std::vector<double>& strikes, bool isCall) const{
+    return zeroCouponBondOptionsImpl(model, InitialRate, expiry, maturity, strikes, isCall);
+}
+
+std::vector<double> COSEngine::capFloors(const VasicekModel& model, double InitialRate, double maturity, double frequency,
+                                         const std::vector<double>& strikes, double notional, bool isCap) const{
+    return capFloorsImpl(model, InitialRate, maturity, frequency, strikes, notional, isCap);
+}
+
+std::vector<double> COSEngine::capFloors(const CIRModel& model, double InitialRate, double maturity, double frequency,
+                                         const std::vector<double>& strikes, double notional, bool isCap) const{
+    return capFloorsImpl(model, InitialRate, maturity, frequency, strikes, notional, isCap);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+
+// Class for Fourier-cosine (COS) pricing of options on the short rate at a single expiry.
+// The discounted characteristic function E[exp(-int_0^T r ds + i u r_T)] is closed-form
+// for both affine models, so its cosine coefficients are computed once per expiry and
+// reused for every strike; a strike then costs one pass over the terms with the payoff
+// integrals in closed form. Coefficients and per-strike work are stored as flat arrays
+// (structure of arrays) so the loops over terms vectorise
+class COSEngine{
+    private:
+        unsigned int Terms;
+        double Truncation;
+
+        // Cosine expansion of the discounted density of r_T on [Lower, Upper]
+        struct Expansion{
+            double Lower;
+            double Upper;
+            std::vector<double> Coefficients;
+        };
+
+        Expansion expansion(const VasicekModel& model, double InitialRate, double expiry) const;
+        Expansion expansion(const CIRModel& model, double InitialRate, double expiry) const;
+        Expansion finish(const std::vector<double>& phiRe, const std::vector<double>& phiIm,
+                         double lower, double upper) const;
+
+        // Options on exp(logA - B r_T) for each strike
+        std::vector<double> bondOptions(const Expansion& density, double logA, double B,
+                                        const std::vector<double>& strikes, bool isCall) const;
+
+        template<typename Model>
+        std::vector<double> zeroCouponBondOptionsImpl(const Model& model, double InitialRate, double expiry, double maturity,
+                                                      const std::vector<double>& strikes, bool isCall) const;
+        template<typename Model>
+        std::vector<double> capFloorsImpl(const Model& model, double InitialRate, double maturity, double frequency,
+                                          const std::vector<double>& strikes, double notional, bool isCap) const;
+
+    public:
+        // Constructor for COSEngine class; the density is truncated at `truncation`
+        // standard deviations either side of the mean of r_T
+        COSEngine(unsigned int terms = 256, double truncation = 10.0);
+
+        // Prices at time 0 of European options expiring at `expiry` on a zero-coupon bond
+        // maturing at `maturity`, one per strike
+        std::vector<double> zeroCouponBondOptions(const VasicekModel& model, double InitialRate, double expiry, double maturity,
+                                                  const std::vector<double>& strikes, bool isCall) const;
+        std::vector<double> zeroCouponBondOptions(const CIRModel& model, double InitialRate, double expiry, double maturity,
+                                                  const std::vector<double>& strikes, bool isCall) const;
+
+        // Prices of caps (or floors) to `maturity` with `frequency` resets a year, one per
+        // strike rate. The first period's rate is already fixed and is left out. Each caplet
+        // is a put on a zero-coupon bond, so every expiry's expansion serves all strikes
+        std::vector<double> capFloors(const VasicekModel& model, double InitialRate, double maturity, double frequency,
+                                      const std::vector<double>& strikes, double notional, bool isCap) const;
+        std::vector<double> capFloors(const CIRModel& model, double InitialRate, double maturity, double frequency,
+                                      const std::vector<double>& strikes, double notional, bool isCap) const;
+};
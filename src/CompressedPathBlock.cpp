@@ -0,0 +1,215 @@
+#include "CompressedPathBlock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Encoded layout: BlockHeader, then (numPaths + 1) byte offsets of the paths relative
+    // to the start, then per path: int64 first value, one width byte per frame padded to
+    // 8 bytes, and the packed frames
+    struct BlockHeader{
+        std::uint64_t NumPaths;
+        std::uint32_t Steps;
+        std::uint32_t Reserved;
+        double Quantum;
+    };
+
+    std::uint64_t zigzag(std::int64_t v){
+        return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t u){
+        return static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1);
+    }
+
+    unsigned int bitWidth(std::uint64_t v){
+        unsigned int width = 0;
+        while (v != 0){
+            ++width;
+            v >>= 1;
+        }
+        return width;
+    }
+
+    std::size_t roundUp8(std::size_t n){
+        return (n + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    BlockHeader readHeader(const unsigned char* bytes){
+        BlockHeader header;
+        std::memcpy(&header, bytes, sizeof(header));
+        return header;
+    }
+}
+
+// Encode a block of paths
+template<typename Real>
+CompressedPathBlock CompressedPathBlock::encode(const Real* paths, std::size_t numPaths, unsigned int steps, double tolerance){
+    CompressedPathBlock block;
+    if (tolerance <= 0){
+        std::cerr << "Compression tolerance must be positive." << std::endl;
+        return block;
+    }
+    const double quantum = 2.0 * tolerance;
+    const double inverse = 1.0 / quantum;
+    const unsigned int frames = (steps + FrameSize - 1) / FrameSize;
+
+    BlockHeader header = {numPaths, steps, 0, quantum};
+    std::size_t offsetsBytes = (numPaths + 1) * sizeof(std::uint64_t);
+    std::vector<std::uint64_t> offsets(numPaths + 1);
+    std::vector<unsigned char>& out = block.Storage;
+    out.resize(sizeof(header) + offsetsBytes);
+
+    std::vector<std::uint64_t> deltas(static_cast<std::size_t>(frames) * FrameSize);
+    std::vector<unsigned char> widths(frames);
+    for (std::size_t p = 0; p < numPaths; ++p){
+        const Real* rates = paths + p * steps;
+        offsets[p] = out.size();
+
+        // Quantise, then zigzag the step deltas; unused slots of the last frame stay zero
+        std::int64_t first = steps > 0 ? std::llround(rates[0] * inverse) : 0;
+        std::int64_t previous = first;
+        std::fill(deltas.begin(), deltas.end(), 0);
+        for (unsigned int i = 1; i < steps; ++i){
+            std::int64_t q = std::llround(rates[i] * inverse);
+            deltas[i] = zigzag(q - previous);
+            previous = q;
+        }
+
+        std::size_t words = 0;
+        for (unsigned int f = 0; f < frames; ++f){
+            std::uint64_t bits = 0;
+            for (unsigned int j = 0; j < FrameSize; ++j){
+                bits |= deltas[f * FrameSize + j];
+            }
+            widths[f] = static_cast<unsigned char>(bitWidth(bits));
+            words += widths[f];
+        }
+
+        std::size_t start = out.size();
+        std::size_t widthsBytes = roundUp8(frames);
+        out.resize(start + sizeof(std::int64_t) + widthsBytes + words * sizeof(std::uint64_t), 0);
+        unsigned char* cursor = out.data() + start;
+        std::memcpy(cursor, &first, sizeof(first));
+        cursor += sizeof(first);
+        std::memcpy(cursor, widths.data(), frames);
+        cursor += widthsBytes;
+
+        // Pack frame by frame: value j of a w-bit frame starts at bit j * w
+        std::vector<std::uint64_t> packed;
+        for (unsigned int f = 0; f < frames; ++f){
+            unsigned int w = widths[f];
+            packed.assign(w, 0);
+            for (unsigned int j = 0; j < FrameSize && w > 0; ++j){
+                std::uint64_t v = deltas[f * FrameSize + j];
+                unsigned int bit = j * w;
+                unsigned int word = bit >> 6;
+                unsigned int shift = bit & 63;
+                packed[word] |= v << shift;
+                if (shift + w > 64){
+                    packed[word + 1] |= v >> (64 - shift);
+                }
+            }
+            std::memcpy(cursor, packed.data(), w * sizeof(std::uint64_t));
+            cursor += w * sizeof(std::uint64_t);
+        }
+    }
+    offsets[numPaths] = out.size();
+
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), offsets.data(), offsetsBytes);
+    return block;
+}
+
+// View encoded bytes in place
+CompressedPathBlock CompressedPathBlock::view(const unsigned char* data, std::size_t size){
+    CompressedPathBlock block;
+    if (size < sizeof(BlockHeader)){
+        std::cerr << "Compressed path block is truncated." << std::endl;
+        return block;
+    }
+    block.External = data;
+    block.ExternalSize = size;
+    return block;
+}
+
+std::size_t CompressedPathBlock::numPaths() const{
+    return size() < sizeof(BlockHeader) ? 0 : readHeader(bytes()).NumPaths;
+}
+
+unsigned int CompressedPathBlock::steps() const{
+    return size() < sizeof(BlockHeader) ? 0 : readHeader(bytes()).Steps;
+}
+
+double CompressedPathBlock::tolerance() const{
+    return size() < sizeof(BlockHeader) ? 0.0 : 0.5 * readHeader(bytes()).Quantum;
+}
+
+// Decode one path
+template<typename Real>
+void CompressedPathBlock::decode(std::size_t path, Real* out) const{
+    const unsigned char* base = bytes();
+    BlockHeader header = readHeader(base);
+    const unsigned int steps = header.Steps;
+    const unsigned int frames = (steps + FrameSize - 1) / FrameSize;
+
+    std::uint64_t offset;
+    std::memcpy(&offset, base + sizeof(header) + path * sizeof(std::uint64_t), sizeof(offset));
+    const unsigned char* cursor = base + offset;
+
+    std::int64_t value;
+    std::memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    const unsigned char* widths = cursor;
+    cursor += roundUp8(frames);
+
+    // Unpack a frame into integers, then take the running sum and scale
+    std::uint64_t words[FrameSize + 1];
+    std::int64_t deltas[FrameSize];
+    for (unsigned int f = 0; f < frames; ++f){
+        unsigned int w = widths[f];
+        std::memcpy(words, cursor, w * sizeof(std::uint64_t));
+        words[w] = 0;
+        cursor += w * sizeof(std::uint64_t);
+
+        if (w == 0){
+            std::fill(deltas, deltas + FrameSize, 0);
+        } else {
+            const std::uint64_t mask = w == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << w) - 1;
+            for (unsigned int j = 0; j < FrameSize; ++j){
+                unsigned int bit = j * w;
+                unsigned int word = bit >> 6;
+                unsigned int shift = bit & 63;
+                std::uint64_t low = words[word] >> shift;
+                std::uint64_t high = shift == 0 ? 0 : words[word + 1] << (64 - shift);
+                deltas[j] = unzigzag((low | high) & mask);
+            }
+        }
+
+        unsigned int first = f * FrameSize;
+        unsigned int count = std::min(FrameSize, steps - first);
+        for (unsigned int j = 0; j < count; ++j){
+            value += deltas[j];
+            out[first + j] = static_cast<Real>(static_cast<double>(value) * header.Quantum);
+        }
+    }
+}
+
+// Decode all paths
+template<typename Real>
+void CompressedPathBlock::decodeAll(Real* out) const{
+    std::size_t paths = numPaths();
+    unsigned int n = steps();
+    for (std::size_t p = 0; p < paths; ++p){
+        decode(p, out + p * n);
+    }
+}
+
+// Double and single precision versions
+template CompressedPathBlock CompressedPathBlock::encode<double>(const double*, std::size_t, unsigned int, double);
+template CompressedPathBlock CompressedPathBlock::encode<float>(const float*, std::size_t, unsigned int, double);
+template void CompressedPathBlock::decode<double>(std::size_t, double*) const;
+template void CompressedPathBlock::decode<float>(std::size_t, float*) const;
+template void CompressedPathBlock::decodeAll<double>(double*) const;
+template void CompressedPathBlock::decodeAll<float>(float*) const;
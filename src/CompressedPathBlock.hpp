@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Class for a block of paths stored lossily in a few bits per rate. Rates are quantised
+// to multiples of 2 * tolerance, so every decoded rate is within tolerance of the
+// original; each path keeps its first quantised value and then zigzag-encoded step
+// deltas, bit-packed in frames of 64 deltas with one width per frame (a frame of width w
+// is exactly w 64-bit words). Smooth paths need 8-16 bits per rate instead of 64.
+// The encoded bytes are self-describing and position independent, so a block can own
+// them or view them in place, e.g. inside a mapped path file
+class CompressedPathBlock{
+    private:
+        std::vector<unsigned char> Storage;
+        const unsigned char* External;
+        std::size_t ExternalSize;
+
+        const unsigned char* bytes() const { return External != nullptr ? External : Storage.data(); }
+
+    public:
+        static constexpr unsigned int FrameSize = 64;
+
+        // Constructor for an empty block
+        CompressedPathBlock() : External(nullptr), ExternalSize(0) {}
+
+        // Encode numPaths path-major paths of `steps` rates each
+        template<typename Real>
+        static CompressedPathBlock encode(const Real* paths, std::size_t numPaths, unsigned int steps, double tolerance);
+
+        // Non-owning view of encoded bytes, which must outlive the view
+        static CompressedPathBlock view(const unsigned char* data, std::size_t size);
+
+        std::size_t numPaths() const;
+        unsigned int steps() const;
+        double tolerance() const;
+
+        // Encoded bytes, for writing the block out
+        const unsigned char* data() const { return bytes(); }
+        std::size_t size() const { return External != nullptr ? ExternalSize : Storage.size(); }
+
+        // Decode one path into out[0 .. steps)
+        template<typename Real>
+        void decode(std::size_t path, Real* out) const;
+
+        // Decode every path, path-major
+        template<typename Real>
+        void decodeAll(Real* out) const;
+};
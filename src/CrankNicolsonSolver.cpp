@@ -0,0 +1,243 @@
+#include "CrankNicolsonSolver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Constructor for CrankNicolsonSolver class
+CrankNicolsonSolver::CrankNicolsonSolver(unsigned int gridPoints, unsigned int stepsPerYear, unsigned int rannacherSteps)
+    : GridPoints(std::max(gridPoints, 5u)), StepsPerYear(std::max(stepsPerYear, 1u)), RannacherSteps(rannacherSteps) {}
+
+// Non-uniform grid wide enough for the rate distribution up to the horizon
+std::vector<double> CrankNicolsonSolver::buildGrid(const InterestRateModel& model, double InitialRate, double horizon) const{
+    // Spread of the rate over the horizon, capped at its stationary level
+    double a = std::max(model.getMeanReversion(), 1e-6);
+    double level = std::max({std::fabs(InitialRate), model.getLongTermMean(), 0.01});
+    double spread = model.diffusion(level, 0.0) * std::sqrt(std::min(horizon, 0.5 / a));
+
+    // Diffusion vanishing at zero means rates stay non-negative
+    bool bounded = model.diffusion(0.0, 0.0) == 0.0;
+    double rMax = std::max(InitialRate, model.getLongTermMean()) + 10.0 * spread;
+    double rMin = bounded ? 0.0 : std::min(InitialRate, model.getLongTermMean()) - 10.0 * spread;
+
+    // r = c + w sinh(u), with nodes uniform in u
+    double centre = std::min(std::max(0.0, rMin), rMax);
+    double width = 0.1 * (rMax - rMin);
+    double lo = std::asinh((rMin - centre) / width);
+    double hi = std::asinh((rMax - centre) / width);
+
+    std::vector<double> grid(GridPoints);
+    for (unsigned int i = 0; i < GridPoints; ++i){
+        double u = lo + (hi - lo) * i / (GridPoints - 1);
+        grid[i] = centre + width * std::sinh(u);
+    }
+    grid.front() = rMin;
+    grid.back() = rMax;
+    return grid;
+}
+
+// Roll all columns back from the last event to time 0 and interpolate at InitialRate
+std::vector<double> CrankNicolsonSolver::rollBack(const InterestRateModel& model, double InitialRate,
+                                                  const std::vector<double>& grid, std::size_t columns,
+                                                  std::vector<Event>& events) const{
+    const std::size_t n = grid.size();
+    const std::size_t K = columns;
+    std::vector<double> values(n * K, 0.0);
+    std::vector<double> rhs(n * K);
+
+    // Operator L V = mu V_r + 0.5 sigma^2 V_rr - r V as tridiagonal rows (lower, diag, upper)
+    std::vector<double> lower(n), diag(n), upper(n);
+    auto assemble = [&](double time){
+        for (std::size_t i = 0; i < n; ++i){
+            double r = grid[i];
+            double mu = model.drift(r, time);
+            if (i == 0 || i + 1 == n){
+                // One-sided first derivative and no curvature at the edges
+                lower[i] = upper[i] = 0.0;
+                diag[i] = -r;
+                if (i == 0){
+                    double h = grid[1] - grid[0];
+                    upper[i] = mu / h;
+                    diag[i] -= mu / h;
+                } else{
+                    double h = grid[i] - grid[i - 1];
+                    lower[i] = -mu / h;
+                    diag[i] += mu / h;
+                }
+                continue;
+            }
+            double hm = grid[i] - grid[i - 1];
+            double hp = grid[i + 1] - grid[i];
+            double sig = model.diffusion(r, time);
+            double halfVar = 0.5 * sig * sig;
+
+            double l = 2.0 * halfVar / (hm * (hm + hp)) - mu * hp / (hm * (hm + hp));
+            double u = 2.0 * halfVar / (hp * (hm + hp)) + mu * hm / (hp * (hm + hp));
+            double d = -2.0 * halfVar / (hm * hp) + mu * (hp - hm) / (hm * hp);
+            if (l < 0.0 || u < 0.0){
+                // Convection dominated: upwind the first derivative to keep the scheme monotone
+                l = 2.0 * halfVar / (hm * (hm + hp)) + (mu < 0.0 ? -mu / hm : 0.0);
+                u = 2.0 * halfVar / (hp * (hm + hp)) + (mu > 0.0 ? mu / hp : 0.0);
+                d = -2.0 * halfVar / (hm * hp) - std::fabs(mu) / (mu > 0.0 ? hp : hm);
+            }
+            lower[i] = l;
+            diag[i] = d - r;
+            upper[i] = u;
+        }
+    };
+
+    // One backward step of size dt: (I - theta dt L) V_new = (I + (1 - theta) dt L) V_old
+    std::vector<double> cPrime(n), inverse(n);
+    auto step = [&](double time, double dt, double theta){
+        assemble(time);
+        double explicitWeight = (1.0 - theta) * dt;
+        if (explicitWeight > 0.0){
+            for (std::size_t i = 0; i < n; ++i){
+                const double* v = &values[i * K];
+                double* out = &rhs[i * K];
+                double l = explicitWeight * lower[i];
+                double d = 1.0 + explicitWeight * diag[i];
+                double u = explicitWeight * upper[i];
+                const double* below = i > 0 ? v - K : v;
+                const double* above = i + 1 < n ? v + K : v;
+                for (std::size_t k = 0; k < K; ++k){
+                    out[k] = l * below[k] + d * v[k] + u * above[k];
+                }
+            }
+        } else{
+            rhs = values;
+        }
+
+        // Thomas algorithm: factorise once, then sweep every column together
+        double b = 1.0 - theta * dt * diag[0];
+        inverse[0] = 1.0 / b;
+        cPrime[0] = -theta * dt * upper[0] * inverse[0];
+        for (std::size_t k = 0; k < K; ++k){
+            rhs[k] *= inverse[0];
+        }
+        for (std::size_t i = 1; i < n; ++i){
+            double a = -theta * dt * lower[i];
+            b = 1.0 - theta * dt * diag[i];
+            inverse[i] = 1.0 / (b - a * cPrime[i - 1]);
+            cPrime[i] = -theta * dt * upper[i] * inverse[i];
+            double* row = &rhs[i * K];
+            const double* prev = &rhs[(i - 1) * K];
+            for (std::size_t k = 0; k < K; ++k){
+                row[k] = (row[k] - a * prev[k]) * inverse[i];
+            }
+        }
+        for (std::size_t i = n - 1; i-- > 0;){
+            double* row = &rhs[i * K];
+            const double* next = &rhs[(i + 1) * K];
+            for (std::size_t k = 0; k < K; ++k){
+                row[k] -= cPrime[i] * next[k];
+            }
+        }
+        values.swap(rhs);
+    };
+
+    // Apply events latest first, stepping between consecutive event dates
+    std::sort(events.begin(), events.end(), [](const Event& x, const Event& y){ return x.Time > y.Time; });
+    std::size_t e = 0;
+    while (e < events.size()){
+        double time = events[e].Time;
+        for (; e < events.size() && events[e].Time >= time - 1e-12; ++e){
+            const Event& ev = events[e];
+            for (std::size_t i = 0; i < n; ++i){
+                values[i * K + ev.Column] += ev.Payoff.empty() ? ev.Amount : ev.Payoff[i];
+            }
+        }
+
+        double next = e < events.size() ? std::max(events[e].Time, 0.0) : 0.0;
+        double gap = time - next;
+        if (gap <= 1e-12){
+            continue;
+        }
+        unsigned int steps = std::max(1u, static_cast<unsigned int>(std::ceil(gap * StepsPerYear - 1e-9)));
+        double dt = gap / steps;
+        double t = time;
+        for (unsigned int s = 0; s < steps; ++s){
+            if (s < RannacherSteps){
+                // Two implicit half steps in place of the first Crank-Nicolson steps
+                step(t - 0.25 * dt, 0.5 * dt, 1.0);
+                step(t - 0.75 * dt, 0.5 * dt, 1.0);
+            } else{
+                step(t - 0.5 * dt, dt, 0.5);
+            }
+            t -= dt;
+        }
+    }
+
+    // Quadratic interpolation at the initial rate
+    std::size_t j = std::upper_bound(grid.begin(), grid.end(), InitialRate) - grid.begin();
+    j = std::min(std::max(j, std::size_t(1)), n - 2);
+    double x0 = grid[j - 1], x1 = grid[j], x2 = grid[j + 1];
+    double x = InitialRate;
+    double w0 = (x - x1) * (x - x2) / ((x0 - x1) * (x0 - x2));
+    double w1 = (x - x0) * (x - x2) / ((x1 - x0) * (x1 - x2));
+    double w2 = (x - x0) * (x - x1) / ((x2 - x0) * (x2 - x1));
+
+    std::vector<double> prices(K);
+    for (std::size_t k = 0; k < K; ++k){
+        prices[k] = w0 * values[(j - 1) * K + k] + w1 * values[j * K + k] + w2 * values[(j + 1) * K + k];
+    }
+    return prices;
+}
+
+// Price a batch of bonds
+std::vector<double> CrankNicolsonSolver::priceBonds(const InterestRateModel& model, double InitialRate,
+                                                    const std::vector<Bond>& bonds) const{
+    std::vector<Event> events;
+    double horizon = 0.0;
+    for (std::size_t k = 0; k < bonds.size(); ++k){
+        for (const CashFlow& cf : bonds[k].cashFlows()){
+            events.push_back({cf.Time, k, cf.Amount, {}});
+            horizon = std::max(horizon, cf.Time);
+        }
+    }
+    if (events.empty()){
+        return std::vector<double>(bonds.size(), 0.0);
+    }
+
+    std::vector<double> grid = buildGrid(model, InitialRate, horizon);
+    return rollBack(model, InitialRate, grid, bonds.size(), events);
+}
+
+// Price a batch of European swaptions
+std::vector<double> CrankNicolsonSolver::priceSwaptions(const InterestRateModel& model, double InitialRate,
+                                                        const std::vector<Swaption>& swaptions, double f, bool isPayer) const{
+    if (f <= 0){
+        std::cerr << "Payment frequency must be positive." << std::endl;
+        return std::vector<double>(swaptions.size(), 0.0);
+    }
+
+    double horizon = 0.0;
+    for (const Swaption& s : swaptions){
+        horizon = std::max(horizon, s.maturity() + s.swapLength());
+    }
+    std::vector<double> grid = buildGrid(model, InitialRate, horizon);
+
+    // Payoff at expiry: notional times (1 - fixed bond) for a payer, the negative for a receiver
+    std::vector<Event> events;
+    for (std::size_t k = 0; k < swaptions.size(); ++k){
+        const Swaption& s = swaptions[k];
+        double expiry = s.maturity();
+        int payments = std::max(1, static_cast<int>(std::lround(s.swapLength() * f)));
+        double coupon = s.strikeRate() / f;
+
+        Event ev{expiry, k, 0.0, std::vector<double>(grid.size())};
+        for (std::size_t i = 0; i < grid.size(); ++i){
+            double fixedBond = 0.0;
+            for (int p = 1; p <= payments; ++p){
+                double pay = expiry + p / f;
+                fixedBond += (coupon + (p == payments ? 1.0 : 0.0)) * model.zeroCouponBondPrice(grid[i], expiry, pay);
+            }
+            double swapValue = isPayer ? 1.0 - fixedBond : fixedBond - 1.0;
+            ev.Payoff[i] = s.notional() * std::max(swapValue, 0.0);
+        }
+        events.push_back(std::move(ev));
+    }
+    if (events.empty()){
+        return {};
+    }
+    return rollBack(model, InitialRate, grid, swaptions.size(), events);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include "InterestRateModel.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+
+// Class for finite-difference pricing under a one-factor model's drift and diffusion.
+// The short-rate grid is a sinh stretch concentrated near r = 0, where CIR diffusion
+// vanishes; time steps are Crank-Nicolson with a Rannacher start (fully implicit half
+// steps) after every payoff date to damp kinks. All instruments passed in one call share
+// the grid, so each step factorises the tridiagonal system once and solves it for every
+// instrument, with values stored interleaved as V[node * instruments + instrument]
+class CrankNicolsonSolver{
+    private:
+        unsigned int GridPoints;
+        unsigned int StepsPerYear;
+        unsigned int RannacherSteps;
+
+        // Cash flow added to one instrument's values at a date: either a constant or a
+        // payoff per grid node
+        struct Event{
+            double Time;
+            std::size_t Column;
+            double Amount;
+            std::vector<double> Payoff;
+        };
+
+        std::vector<double> buildGrid(const InterestRateModel& model, double InitialRate, double horizon) const;
+        std::vector<double> rollBack(const InterestRateModel& model, double InitialRate, const std::vector<double>& grid,
+                                     std::size_t columns, std::vector<Event>& events) const;
+
+    public:
+        // Constructor for CrankNicolsonSolver class
+        CrankNicolsonSolver(unsigned int gridPoints = 201, unsigned int stepsPerYear = 100, unsigned int rannacherSteps = 2);
+
+        // Prices of a batch of bonds at short rate InitialRate
+        std::vector<double> priceBonds(const InterestRateModel& model, double InitialRate, const std::vector<Bond>& bonds) const;
+
+        // Prices of a batch of European swaptions with f fixed payments a year, exercised
+        // into the swap at its model value (zero-coupon prices from the model)
+        std::vector<double> priceSwaptions(const InterestRateModel& model, double InitialRate,
+                                           const std::vector<Swaption>& swaptions, double f, bool isPayer) const;
+
+        // Short-rate grid used for a given model, initial rate and horizon
+        std::vector<double> grid(const InterestRateModel& model, double InitialRate, double horizon) const{
+            return buildGrid(model, InitialRate, horizon);
+        }
+};
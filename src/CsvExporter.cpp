@@ -0,0 +1,259 @@
+#include "CsvExporter.hpp"
+#include "Instrumentation.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    // Longest formatted number plus separator
+    const std::size_t MaxCell = 40;
+
+    // Buffers in flight between the formatter and the writer thread
+    const std::size_t PoolSize = 3;
+
+    // Background writer: full buffers are queued, written in order, then recycled
+    class BufferWriter{
+        private:
+            int Fd;
+            bool Failed;
+            bool Done;
+            std::deque<std::vector<char>> Full;
+            std::deque<std::vector<char>> Free;
+            std::mutex Lock;
+            std::condition_variable Changed;
+            std::thread Worker;
+
+            void run(){
+                for (;;){
+                    std::vector<char> buffer;
+                    {
+                        std::unique_lock<std::mutex> guard(Lock);
+                        Changed.wait(guard, [&]{ return !Full.empty() || Done; });
+                        if (Full.empty()){
+                            return;
+                        }
+                        buffer.swap(Full.front());
+                        Full.pop_front();
+                    }
+
+                    const char* data = buffer.data();
+                    std::size_t length = buffer.size();
+                    bool ok = true;
+                    IR_PROFILE_SCOPE(Io);
+                    TraceScope trace("write", "io", static_cast<std::int64_t>(length));
+                    while (ok && length > 0){
+                        ssize_t written = ::write(Fd, data, length);
+                        ok = written > 0;
+                        if (ok){
+                            data += written;
+                            length -= static_cast<std::size_t>(written);
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> guard(Lock);
+                    Failed = Failed || !ok;
+                    buffer.clear();
+                    Free.push_back(std::move(buffer));
+                    Changed.notify_all();
+                }
+            }
+
+        public:
+            BufferWriter(int fd, std::size_t capacity) : Fd(fd), Failed(false), Done(false){
+                for (std::size_t i = 0; i < PoolSize; ++i){
+                    Free.emplace_back();
+                    Free.back().reserve(capacity);
+                }
+                Worker = std::thread(&BufferWriter::run, this);
+            }
+
+            // Take an empty buffer, waiting for the writer if all are in flight
+            std::vector<char> acquire(){
+                TraceScope trace("wait for buffer", "io");
+                std::unique_lock<std::mutex> guard(Lock);
+                Changed.wait(guard, [&]{ return !Free.empty(); });
+                std::vector<char> buffer = std::move(Free.front());
+                Free.pop_front();
+                return buffer;
+            }
+
+            // Queue a filled buffer for writing
+            void submit(std::vector<char>& buffer){
+                std::lock_guard<std::mutex> guard(Lock);
+                Full.push_back(std::move(buffer));
+                Changed.notify_all();
+            }
+
+            // Drain the queue and stop; false if any write failed
+            bool finish(){
+                {
+                    std::lock_guard<std::mutex> guard(Lock);
+                    Done = true;
+                    Changed.notify_all();
+                }
+                Worker.join();
+                return !Failed;
+            }
+    };
+}
+
+// Constructor for CsvExporter class
+CsvExporter::CsvExporter(std::size_t bufferBytes, int precision)
+    : BufferBytes(std::max<std::size_t>(bufferBytes, 4096)), Precision(precision), TimeStep(0.0),
+      PathColumn(true), StepColumn(true), TimeColumn(false),
+      FirstPath(0), LastPath(std::numeric_limits<std::size_t>::max()) {}
+
+// Add an in-memory column
+void CsvExporter::addSeries(const std::string& name, const double* paths, std::size_t numPaths, unsigned int steps){
+    Columns.push_back({name, paths, nullptr, nullptr, numPaths, steps});
+}
+
+void CsvExporter::addSeries(const std::string& name, const float* paths, std::size_t numPaths, unsigned int steps){
+    Columns.push_back({name, nullptr, paths, nullptr, numPaths, steps});
+}
+
+// Add a column from a path file
+void CsvExporter::addSeries(const std::string& name, const PathStore& store){
+    Columns.push_back({name, nullptr, nullptr, &store, store.numPaths(), store.steps()});
+}
+
+// Select the index columns
+void CsvExporter::setIndexColumns(bool path, bool step, bool time, double timeStep){
+    PathColumn = path;
+    StepColumn = step;
+    TimeColumn = time;
+    TimeStep = timeStep;
+}
+
+// Select a range of paths
+void CsvExporter::setPathRange(std::size_t first, std::size_t last){
+    FirstPath = first;
+    LastPath = last;
+}
+
+// Rates of one path as a contiguous array of doubles
+const double* CsvExporter::pathRates(const Series& series, std::size_t path, std::vector<double>& scratch) const{
+    unsigned int steps = series.Steps;
+    if (series.Doubles != nullptr){
+        return series.Doubles + path * steps;
+    }
+    if (series.Floats != nullptr){
+        const float* rates = series.Floats + path * steps;
+        std::copy(rates, rates + steps, scratch.begin());
+        return scratch.data();
+    }
+
+    const PathStore& store = *series.Store;
+    std::size_t blockPaths = store.header().BlockPaths;
+    if (store.compressed()){
+        store.compressedBlock(path / blockPaths).decode(path % blockPaths, scratch.data());
+        return scratch.data();
+    }
+    if (store.header().Layout == PathLayout::PathMajor && store.header().ScalarBytes == sizeof(double)){
+        return store.block<double>(path / blockPaths) + (path % blockPaths) * steps;
+    }
+    for (unsigned int i = 0; i < steps; ++i){
+        scratch[i] = store.header().ScalarBytes == sizeof(double) ? store.rate<double>(path, i)
+                                                                   : static_cast<double>(store.rate<float>(path, i));
+    }
+    return scratch.data();
+}
+
+// Write the CSV file
+bool CsvExporter::write(const std::string& filename) const{
+    if (Columns.empty()){
+        std::cerr << "No series to export." << std::endl;
+        return false;
+    }
+    std::size_t numPaths = Columns[0].NumPaths;
+    unsigned int steps = Columns[0].Steps;
+    for (const Series& series : Columns){
+        if (series.NumPaths != numPaths || series.Steps != steps){
+            std::cerr << "Series " << series.Name << " does not match the shape of " << Columns[0].Name << "." << std::endl;
+            return false;
+        }
+    }
+    std::size_t first = std::min(FirstPath, numPaths);
+    std::size_t last = std::min(LastPath, numPaths);
+
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0){
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    BufferWriter writer(fd, BufferBytes);
+    std::vector<char> buffer = writer.acquire();
+
+    // Header row
+    std::string header;
+    if (PathColumn) header += "Path,";
+    if (StepColumn) header += "Step,";
+    if (TimeColumn) header += "Time,";
+    for (const Series& series : Columns){
+        header += series.Name;
+        header += ',';
+    }
+    header.back() = '\n';
+    buffer.insert(buffer.end(), header.begin(), header.end());
+
+    // Format into the spare capacity of the buffer, handing it over whenever the next
+    // row might not fit
+    std::size_t rowBytes = (3 + Columns.size()) * MaxCell;
+    std::vector<std::vector<double>> scratch(Columns.size(), std::vector<double>(steps));
+    std::vector<const double*> rates(Columns.size());
+    std::vector<char> row(rowBytes);
+
+    auto number = [&](char* out, double value){
+        std::to_chars_result result = Precision > 0
+            ? std::to_chars(out, out + MaxCell, value, std::chars_format::general, Precision)
+            : std::to_chars(out, out + MaxCell, value);
+        return result.ptr;
+    };
+    auto integer = [](char* out, std::size_t value){
+        return std::to_chars(out, out + MaxCell, value).ptr;
+    };
+
+    for (std::size_t p = first; p < last; ++p){
+        for (std::size_t c = 0; c < Columns.size(); ++c){
+            rates[c] = pathRates(Columns[c], p, scratch[c]);
+        }
+        for (unsigned int i = 0; i < steps; ++i){
+            char* out = row.data();
+            if (PathColumn){ out = integer(out, p); *out++ = ','; }
+            if (StepColumn){ out = integer(out, i); *out++ = ','; }
+            if (TimeColumn){
+                out = std::to_chars(out, out + MaxCell, (i + 1) * TimeStep, std::chars_format::general, 12).ptr;
+                *out++ = ',';
+            }
+            for (std::size_t c = 0; c < Columns.size(); ++c){
+                out = number(out, rates[c][i]);
+                *out++ = ',';
+            }
+            out[-1] = '\n';
+
+            std::size_t length = static_cast<std::size_t>(out - row.data());
+            if (buffer.size() + length > BufferBytes){
+                writer.submit(buffer);
+                buffer = writer.acquire();
+            }
+            buffer.insert(buffer.end(), row.data(), out);
+        }
+    }
+    writer.submit(buffer);
+
+    bool ok = writer.finish();
+    if (::close(fd) != 0 || !ok){
+        std::cerr << "Failed to properly write the file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
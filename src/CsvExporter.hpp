@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "PathStore.hpp"
+
+// Class for exporting simulated paths to CSV. Each added series (e.g. one model's paths)
+// becomes a column, optionally preceded by path, step and time index columns; one row is
+// written per (path, step) for the selected path range. Numbers are formatted with
+// std::to_chars into large buffers which a background thread writes to the file while
+// the next buffer is being filled
+class CsvExporter{
+    private:
+        // A column of rates: path-major in memory (double or float), or a path file
+        struct Series{
+            std::string Name;
+            const double* Doubles;
+            const float* Floats;
+            const PathStore* Store;
+            std::size_t NumPaths;
+            unsigned int Steps;
+        };
+
+        std::vector<Series> Columns;
+        std::size_t BufferBytes;
+        int Precision;
+        double TimeStep;
+        bool PathColumn;
+        bool StepColumn;
+        bool TimeColumn;
+        std::size_t FirstPath;
+        std::size_t LastPath;
+
+        const double* pathRates(const Series& series, std::size_t path, std::vector<double>& scratch) const;
+
+    public:
+        // Constructor for CsvExporter class; precision 0 writes the shortest representation
+        // that reads back exactly, otherwise that many significant digits
+        CsvExporter(std::size_t bufferBytes = 1 << 22, int precision = 0);
+
+        // Add a column of numPaths paths with `steps` rates each, stored path-major
+        void addSeries(const std::string& name, const double* paths, std::size_t numPaths, unsigned int steps);
+        void addSeries(const std::string& name, const float* paths, std::size_t numPaths, unsigned int steps);
+
+        // Add a column read from a mapped path file, which must stay open while writing
+        void addSeries(const std::string& name, const PathStore& store);
+
+        // Select the index columns; time is (step + 1) * timeStep, the date of each rate
+        void setIndexColumns(bool path, bool step, bool time, double timeStep = 0.0);
+
+        // Export only paths [first, last); by default every path
+        void setPathRange(std::size_t first, std::size_t last);
+
+        // Write the CSV file, returning false on error
+        bool write(const std::string& filename) const;
+};
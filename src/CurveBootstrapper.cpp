@@ -0,0 +1,99 @@
+#include "CurveBootstrapper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Simple-interest deposit
+void CurveBootstrapper::addDeposit(double maturity, double rate){
+    Instruments.push_back({maturity, {CashFlow{-1, maturity, 1.0 + rate * maturity}}, 1.0});
+}
+
+// Par swap: fixed coupons plus notional at maturity are worth par
+void CurveBootstrapper::addSwap(double maturity, double parRate, double frequency){
+    Instrument swap{maturity, {}, 1.0};
+    int payments = static_cast<int>(std::round(maturity * frequency));
+    for (int i = 1; i <= payments; ++i){
+        swap.Flows.push_back({-1, i / frequency, parRate / frequency});
+    }
+    swap.Flows.push_back({-1, maturity, 1.0});
+    Instruments.push_back(swap);
+}
+
+// Coupon bond at its market price
+void CurveBootstrapper::addBond(const Bond& bond, double price){
+    std::vector<CashFlow> flows = bond.cashFlows();
+    Instruments.push_back({flows.back().Time, flows, price});
+}
+
+// Present value of an instrument's cash flows
+double CurveBootstrapper::value(const Instrument& instrument, const YieldCurve& curve) const{
+    std::vector<double> times;
+    for (const CashFlow& cf : instrument.Flows) times.push_back(cf.Time);
+    std::vector<double> dfs = curve.discountFactors(times);
+
+    double pv = 0.0;
+    for (std::size_t k = 0; k < dfs.size(); ++k){
+        pv += instrument.Flows[k].Amount * dfs[k];
+    }
+    return pv;
+}
+
+// Build the curve
+YieldCurve CurveBootstrapper::bootstrap(Interpolation method) const{
+    if (Instruments.empty()){
+        std::cerr << "No instruments to bootstrap." << std::endl;
+        return YieldCurve({1.0}, {1.0}, method);
+    }
+
+    std::vector<Instrument> sorted = Instruments;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Instrument& x, const Instrument& y){ return x.Maturity < y.Maturity; });
+
+    std::vector<double> times;
+    std::vector<double> logDfs;
+    for (const Instrument& instrument : sorted){
+        if (!times.empty() && instrument.Maturity <= times.back()){
+            std::cerr << "Skipping instrument with duplicate maturity " << instrument.Maturity << std::endl;
+            continue;
+        }
+        times.push_back(instrument.Maturity);
+        logDfs.push_back(logDfs.empty() ? -0.03 * instrument.Maturity : logDfs.back());
+    }
+
+    auto buildCurve = [&](){
+        std::vector<double> dfs(logDfs.size());
+        for (std::size_t k = 0; k < dfs.size(); ++k) dfs[k] = std::exp(logDfs[k]);
+        return YieldCurve(times, dfs, method);
+    };
+
+    // Log-linear nodes only depend on earlier nodes, so one sweep is exact. Monotone convex
+    // couples neighbouring segments, so sweep until the nodes stop moving
+    int sweeps = method == Interpolation::LogLinear ? 1 : 50;
+    for (int sweep = 0; sweep < sweeps; ++sweep){
+        double maxChange = 0.0;
+        std::size_t node = 0;
+        for (const Instrument& instrument : sorted){
+            if (node >= times.size() || instrument.Maturity != times[node]) continue;
+
+            // Secant iterations on the log discount factor of this node
+            double start = logDfs[node];
+            double x0 = start;
+            double x1 = start - 1e-4;
+            logDfs[node] = x0;
+            double f0 = value(instrument, buildCurve()) - instrument.Target;
+            for (int it = 0; it < 50 && std::fabs(f0) > 1e-14; ++it){
+                logDfs[node] = x1;
+                double f1 = value(instrument, buildCurve()) - instrument.Target;
+                if (f1 == f0) break;
+                double x2 = x1 - f1 * (x1 - x0) / (f1 - f0);
+                x0 = x1; f0 = f1; x1 = x2;
+            }
+            logDfs[node] = x0;
+            maxChange = std::max(maxChange, std::fabs(x0 - start));
+            ++node;
+        }
+        if (sweep > 0 && maxChange < 1e-14) break;
+    }
+
+    return buildCurve();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include "Bond.hpp"
+#include "YieldCurve.hpp"
+
+// Class for bootstrapping a YieldCurve from deposits, par swaps and bond prices.
+// Each instrument places a node at its maturity; node discount factors are solved one at a
+// time so every instrument reprices exactly under the chosen interpolation
+class CurveBootstrapper{
+    private:
+        // Instrument expressed as fixed cash flows that must be worth Target;
+        // a par swap is its fixed leg plus notional, worth par
+        struct Instrument{
+            double Maturity;
+            std::vector<CashFlow> Flows;
+            double Target;
+        };
+
+        std::vector<Instrument> Instruments;
+
+        double value(const Instrument& instrument, const YieldCurve& curve) const;
+
+    public:
+        // Simple-interest deposit: 1 invested pays 1 + rate * maturity
+        void addDeposit(double maturity, double rate);
+
+        // Par swap with fixed payments `frequency` times a year
+        void addSwap(double maturity, double parRate, double frequency);
+
+        // Coupon bond with a market (dirty) price
+        void addBond(const Bond& bond, double price);
+
+        // Build the curve
+        YieldCurve bootstrap(Interpolation method = Interpolation::LogLinear) const;
+};
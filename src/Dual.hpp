@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Forward-mode dual number carrying N tangent directions at once
+template<std::size_t N>
+class Dual{
+    public:
+        double Value;
+        std::array<double, N> Tangent;
+
+        // Constructor for a constant (all tangents zero)
+        Dual(double v = 0.0) : Value(v){
+            Tangent.fill(0.0);
+        }
+
+        // Constructor for an input variable seeded in tangent direction dir
+        Dual(double v, std::size_t dir) : Value(v){
+            Tangent.fill(0.0);
+            Tangent[dir] = 1.0;
+        }
+
+        // Derivative in tangent direction i
+        double d(std::size_t i) const { return Tangent[i]; }
+
+        Dual& operator+=(const Dual& o){
+            Value += o.Value;
+            for (std::size_t i = 0; i < N; ++i) Tangent[i] += o.Tangent[i];
+            return *this;
+        }
+
+        Dual& operator-=(const Dual& o){
+            Value -= o.Value;
+            for (std::size_t i = 0; i < N; ++i) Tangent[i] -= o.Tangent[i];
+            return *this;
+        }
+
+        Dual& operator*=(const Dual& o){
+            for (std::size_t i = 0; i < N; ++i) Tangent[i] = Tangent[i] * o.Value + Value * o.Tangent[i];
+            Value *= o.Value;
+            return *this;
+        }
+
+        Dual& operator/=(const Dual& o){
+            double inv = 1.0 / o.Value;
+            for (std::size_t i = 0; i < N; ++i) Tangent[i] = (Tangent[i] - Value * inv * o.Tangent[i]) * inv;
+            Value *= inv;
+            return *this;
+        }
+
+        Dual& operator+=(double c){ Value += c; return *this; }
+        Dual& operator-=(double c){ Value -= c; return *this; }
+
+        Dual& operator*=(double c){
+            Value *= c;
+            for (std::size_t i = 0; i < N; ++i) Tangent[i] *= c;
+            return *this;
+        }
+
+        Dual& operator/=(double c){ return *this *= (1.0 / c); }
+};
+
+// Apply the chain rule for a unary function with value f and derivative df
+template<std::size_t N>
+Dual<N> chain(const Dual<N>& x, double f, double df){
+    Dual<N> r(f);
+    for (std::size_t i = 0; i < N; ++i) r.Tangent[i] = df * x.Tangent[i];
+    return r;
+}
+
+// Arithmetic operators
+template<std::size_t N> Dual<N> operator-(const Dual<N>& x){ return chain(x, -x.Value, -1.0); }
+
+template<std::size_t N> Dual<N> operator+(Dual<N> a, const Dual<N>& b){ return a += b; }
+template<std::size_t N> Dual<N> operator-(Dual<N> a, const Dual<N>& b){ return a -= b; }
+template<std::size_t N> Dual<N> operator*(Dual<N> a, const Dual<N>& b){ return a *= b; }
+template<std::size_t N> Dual<N> operator/(Dual<N> a, const Dual<N>& b){ return a /= b; }
+
+template<std::size_t N> Dual<N> operator+(Dual<N> a, double c){ return a += c; }
+template<std::size_t N> Dual<N> operator-(Dual<N> a, double c){ return a -= c; }
+template<std::size_t N> Dual<N> operator*(Dual<N> a, double c){ return a *= c; }
+template<std::size_t N> Dual<N> operator/(Dual<N> a, double c){ return a /= c; }
+
+template<std::size_t N> Dual<N> operator+(double c, Dual<N> a){ return a += c; }
+template<std::size_t N> Dual<N> operator-(double c, const Dual<N>& a){ return -a + c; }
+template<std::size_t N> Dual<N> operator*(double c, Dual<N> a){ return a *= c; }
+template<std::size_t N> Dual<N> operator/(double c, const Dual<N>& a){ return Dual<N>(c) / a; }
+
+// Comparisons act on the value only
+template<std::size_t N> bool operator<(const Dual<N>& a, double c){ return a.Value < c; }
+template<std::size_t N> bool operator>(const Dual<N>& a, double c){ return a.Value > c; }
+template<std::size_t N> bool operator<(const Dual<N>& a, const Dual<N>& b){ return a.Value < b.Value; }
+template<std::size_t N> bool operator>(const Dual<N>& a, const Dual<N>& b){ return a.Value > b.Value; }
+
+// Elementary functions, found by argument-dependent lookup from templated code
+template<std::size_t N> Dual<N> exp(const Dual<N>& x){
+    double e = std::exp(x.Value);
+    return chain(x, e, e);
+}
+
+template<std::size_t N> Dual<N> log(const Dual<N>& x){
+    return chain(x, std::log(x.Value), 1.0 / x.Value);
+}
+
+template<std::size_t N> Dual<N> log1p(const Dual<N>& x){
+    return chain(x, std::log1p(x.Value), 1.0 / (1.0 + x.Value));
+}
+
+template<std::size_t N> Dual<N> sqrt(const Dual<N>& x){
+    double s = std::sqrt(x.Value);
+    return chain(x, s, 0.5 / s);
+}
+
+template<std::size_t N> Dual<N> pow(const Dual<N>& x, double p){
+    return chain(x, std::pow(x.Value, p), p * std::pow(x.Value, p - 1.0));
+}
+
+template<std::size_t N> Dual<N> erfc(const Dual<N>& x){
+    const double twoOverSqrtPi = 1.1283791670955126;
+    return chain(x, std::erfc(x.Value), -twoOverSqrtPi * std::exp(-x.Value * x.Value));
+}
@@ -0,0 +1,106 @@
+#include "HullWhiteModel.hpp"
+#include <cmath>
+#include <iostream>
+
+// Constructor for HullWhiteModel class; the long-term mean is replaced by theta(t)
+HullWhiteModel::HullWhiteModel(double MeanRev, double Vol, const YieldCurve& curve)
+    : InterestRateModel(MeanRev, 0.0, Vol), Curve(curve), TableTimeStep(0.0),
+      TableMeanReversion(0.0), TableVolatility(0.0), CurrentTime(0.0) {}
+
+// Mean of the short rate at time t
+double HullWhiteModel::alpha(double time) const{
+    double a = MeanReversion;
+    double decay = 1.0 - std::exp(-a * time);
+    return Curve.forwardRate(time) + Volatility * Volatility / (2.0 * a * a) * decay * decay;
+}
+
+// Deterministic part of the exact step from time to time + timeStep
+double HullWhiteModel::stepDrift(double time, double timeStep) const{
+    return alpha(time + timeStep) - alpha(time) * std::exp(-MeanReversion * timeStep);
+}
+
+// Precompute the drift table
+void HullWhiteModel::prepareGrid(double timeStep, unsigned int steps){
+    DriftTable.resize(steps);
+    for (unsigned int i = 0; i < steps; ++i){
+        DriftTable[i] = stepDrift(i * timeStep, timeStep);
+    }
+    TableTimeStep = timeStep;
+    TableMeanReversion = MeanReversion;
+    TableVolatility = Volatility;
+}
+
+// Simulate next interest rate using the Hull-White model
+double HullWhiteModel::simulateNextRate(double currentRate, double timeStep){
+    if(timeStep < 0){
+        std::cerr << "Time step may not be negative." << std::endl;
+        return 0;
+    }
+
+    // Generate normal random variable
+    double dw = distribution(generator);
+
+    double nextRateValue = nextRate(currentRate, CurrentTime, timeStep, dw);
+    CurrentTime += timeStep;
+    return nextRateValue;
+}
+
+// Advance a rate by one exact step
+double HullWhiteModel::nextRate(double currentRate, double time, double timeStep, double dw) const{
+    double a = MeanReversion;
+    double decay = std::exp(-a * timeStep);
+    double stdDev = Volatility * std::sqrt((1.0 - decay * decay) / (2.0 * a));
+
+    // Table lookup when the step lies on the prepared grid with current parameters
+    double d;
+    double index = time / timeStep;
+    std::size_t i = static_cast<std::size_t>(index + 0.5);
+    if (timeStep == TableTimeStep && a == TableMeanReversion && Volatility == TableVolatility
+        && i < DriftTable.size() && std::fabs(index - i) < 1e-9){
+        d = DriftTable[i];
+    } else {
+        d = stepDrift(time, timeStep);
+    }
+    return currentRate * decay + d + stdDev * dw;
+}
+
+// theta(t) = df/dt + a f + sigma^2 / (2a) (1 - e^{-2at})
+double HullWhiteModel::theta(double time) const{
+    double a = MeanReversion;
+    double h = 1e-5;
+    double slope = (Curve.forwardRate(time + h) - Curve.forwardRate(std::max(time - h, 0.0))) / (time + h - std::max(time - h, 0.0));
+    return slope + a * Curve.forwardRate(time)
+            + Volatility * Volatility / (2.0 * a) * (1.0 - std::exp(-2.0 * a * time));
+}
+
+// Analytic zero-coupon bond price P(t, T) given r(t)
+double HullWhiteModel::zeroCouponBondPrice(double rate, double time, double maturity) const{
+    double a = MeanReversion;
+    double B = (1.0 - std::exp(-a * (maturity - time))) / a;
+    std::vector<double> dfs = Curve.discountFactors({time, maturity});
+    double logA = std::log(dfs[1] / dfs[0]) + B * Curve.forwardRate(time)
+                    - Volatility * Volatility / (4.0 * a) * (1.0 - std::exp(-2.0 * a * time)) * B * B;
+    return std::exp(logA - B * rate);
+}
+
+// Analytic option on a zero-coupon bond (Jamshidian)
+double HullWhiteModel::zeroCouponBondOption(double expiry, double maturity, double strike, bool isCall) const{
+    double a = MeanReversion;
+    std::vector<double> dfs = Curve.discountFactors({expiry, maturity});
+    double pExpiry = dfs[0];
+    double pMaturity = dfs[1];
+
+    double sigmaP = Volatility / a * (1.0 - std::exp(-a * (maturity - expiry)))
+                    * std::sqrt((1.0 - std::exp(-2.0 * a * expiry)) / (2.0 * a));
+    if (sigmaP <= 0){
+        double intrinsic = isCall ? pMaturity - strike * pExpiry : strike * pExpiry - pMaturity;
+        return std::max(intrinsic, 0.0);
+    }
+
+    double h = std::log(pMaturity / (pExpiry * strike)) / sigmaP + 0.5 * sigmaP;
+    auto N = [](double x){ return 0.5 * std::erfc(-x * std::sqrt(0.5)); };
+    if (isCall){
+        return pMaturity * N(h) - strike * pExpiry * N(h - sigmaP);
+    }
+    return strike * pExpiry * N(sigmaP - h) - pMaturity * N(-h);
+}
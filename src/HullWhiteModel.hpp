@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include "InterestRateModel.hpp"
+#include "YieldCurve.hpp"
+
+// Class to implement the Hull-White one-factor model dr = (theta(t) - a r) dt + sigma dW,
+// with theta(t) chosen so the model reprices the supplied initial curve exactly.
+// Simulation uses the exact Gaussian transition r' = r e^{-a dt} + D(t) + s Z, and the
+// deterministic part D is precomputed per grid step by prepareGrid() into a flat table,
+// so a step costs the same as a Vasicek step
+class HullWhiteModel : public InterestRateModel{
+    private:
+        YieldCurve Curve;
+
+        // Drift table for one uniform grid, with the parameters it was built for
+        std::vector<double> DriftTable;
+        double TableTimeStep;
+        double TableMeanReversion;
+        double TableVolatility;
+
+        // Clock for the stateful simulateNextRate interface
+        double CurrentTime;
+
+        // alpha(t) = f(0,t) + sigma^2 / (2a^2) (1 - e^{-at})^2, the mean of r(t)
+        double alpha(double time) const;
+        double stepDrift(double time, double timeStep) const;
+
+    public:
+        // Constructor for HullWhiteModel class
+        HullWhiteModel(double MeanRev, double Vol, const YieldCurve& curve);
+
+        // Precompute the drift for `steps` steps of size timeStep
+        void prepareGrid(double timeStep, unsigned int steps);
+
+        // Simulate next interest rate, advancing the model's own clock
+        double simulateNextRate(double currentRate, double timeStep);
+
+        void startPath(){ CurrentTime = 0.0; }
+
+        // Advance a rate given the normal draw; uses the drift table when time is on its grid
+        double nextRate(double currentRate, double time, double timeStep, double dw) const;
+
+        // theta(t) of the SDE
+        double theta(double time) const;
+
+        double drift(double rate, double time) const { return theta(time) - MeanReversion * rate; }
+
+        // Short rate at time 0 implied by the curve
+        double initialRate() const { return Curve.forwardRate(0.0); }
+
+        // Analytic zero-coupon bond price P(t, T) given r(t)
+        double zeroCouponBondPrice(double rate, double time, double maturity) const;
+
+        // Analytic price at time 0 of a European option expiring at `expiry` on a zero-coupon
+        // bond maturing at `maturity`, e.g. as a control variate for Monte Carlo
+        double zeroCouponBondOption(double expiry, double maturity, double strike, bool isCall) const;
+
+        std::unique_ptr<InterestRateModel> clone() const{
+            return std::make_unique<HullWhiteModel>(*this);
+        }
+
+        const YieldCurve& curve() const { return Curve; }
+
+        // The lattice uses dx = -a x dt + sigma dW (the base default with zero long-term mean)
+        // and is shifted level by level to reprice this curve
+        const YieldCurve* initialCurve() const { return &Curve; }
+};
@@ -0,0 +1,116 @@
+#include "Instrumentation.hpp"
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+
+thread_local Instrumentation::Release Instrumentation::Releaser;
+
+// Allocate or reuse a profile for the calling thread
+Instrumentation::ThreadProfile* Instrumentation::registerThread(){
+    ThreadProfile* profile;
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (!FreeProfiles.empty()){
+            profile = FreeProfiles.back();
+            FreeProfiles.pop_back();
+        }
+        else{
+            Profiles.push_back(std::make_unique<ThreadProfile>());
+            profile = Profiles.back().get();
+        }
+    }
+    Releaser.Profile = profile;
+    return profile;
+}
+
+void Instrumentation::releaseThread(ThreadProfile* profile){
+    std::lock_guard<std::mutex> lock(Mutex);
+    FreeProfiles.push_back(profile);
+    Local = nullptr;
+}
+
+Instrumentation::ThreadProfile Instrumentation::totals(){
+    std::lock_guard<std::mutex> lock(Mutex);
+    ThreadProfile sum;
+    for (const std::unique_ptr<ThreadProfile>& profile : Profiles){
+        for (std::size_t i = 0; i < NumPhases; ++i){
+            sum.Ticks[i] += profile->Ticks[i];
+            sum.Calls[i] += profile->Calls[i];
+        }
+        for (std::size_t i = 0; i < NumCounters; ++i){
+            sum.Counters[i] += profile->Counters[i];
+        }
+    }
+    return sum;
+}
+
+void Instrumentation::reset(){
+    std::lock_guard<std::mutex> lock(Mutex);
+    for (std::unique_ptr<ThreadProfile>& profile : Profiles){
+        *profile = ThreadProfile();
+    }
+}
+
+std::size_t Instrumentation::threadCount(){
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Profiles.size();
+}
+
+// Spin for a few milliseconds and compare the two clocks
+double Instrumentation::ticksPerSecond(){
+    static const double rate = []{
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t first = ticks();
+        double elapsed = 0.0;
+        while (elapsed < 0.02){
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return (ticks() - first) / elapsed;
+    }();
+    return rate;
+}
+
+const char* Instrumentation::phaseName(ProfilePhase phase){
+    switch (phase){
+        case ProfilePhase::Rng: return "rng";
+        case ProfilePhase::Stepping: return "stepping";
+        case ProfilePhase::Payoff: return "payoff";
+        case ProfilePhase::Io: return "io";
+        default: return "?";
+    }
+}
+
+const char* Instrumentation::counterName(ProfileCounter counter){
+    switch (counter){
+        case ProfileCounter::Steps: return "steps";
+        case ProfileCounter::Paths: return "paths";
+        case ProfileCounter::Allocations: return "allocations";
+        case ProfileCounter::RejectedSamples: return "rejected samples";
+        default: return "?";
+    }
+}
+
+// Times are summed over threads, so with parallel workers they can exceed wall time
+void Instrumentation::report(std::ostream& out){
+    ThreadProfile sum = totals();
+    double rate = ticksPerSecond();
+    double totalSeconds = 0.0;
+    for (std::size_t i = 0; i < NumPhases; ++i) totalSeconds += sum.Ticks[i] / rate;
+
+    out << "Instrumentation report (" << threadCount() << " thread profiles)\n";
+    out << std::left << std::setw(12) << "phase" << std::right << std::setw(14) << "calls"
+        << std::setw(14) << "seconds" << std::setw(10) << "share" << "\n";
+    for (std::size_t i = 0; i < NumPhases; ++i){
+        double seconds = sum.Ticks[i] / rate;
+        double share = totalSeconds > 0.0 ? 100.0 * seconds / totalSeconds : 0.0;
+        out << std::left << std::setw(12) << phaseName(static_cast<ProfilePhase>(i)) << std::right
+            << std::setw(14) << sum.Calls[i] << std::setw(14) << std::fixed << std::setprecision(6) << seconds
+            << std::setw(9) << std::setprecision(1) << share << "%\n";
+    }
+    out.unsetf(std::ios::floatfield);
+    for (std::size_t i = 0; i < NumCounters; ++i){
+        out << std::left << std::setw(18) << counterName(static_cast<ProfileCounter>(i)) << std::right
+            << std::setw(20) << sum.Counters[i] << "\n";
+    }
+    out << std::flush;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Phases timed by the instrumentation layer
+enum class ProfilePhase{ Rng, Stepping, Payoff, Io, Count };
+
+// Events counted by the instrumentation layer
+enum class ProfileCounter{ Steps, Paths, Allocations, RejectedSamples, Count };
+
+// Hot-path timers and counters. Every thread accumulates into its own ThreadProfile,
+// so recording is a thread-local add with no synchronisation; totals are summed when
+// the report is produced. The call sites use the IR_PROFILE_SCOPE and IR_COUNT macros,
+// which compile to nothing unless IRMODELING_INSTRUMENT is defined
+class Instrumentation{
+    public:
+        static constexpr std::size_t NumPhases = static_cast<std::size_t>(ProfilePhase::Count);
+        static constexpr std::size_t NumCounters = static_cast<std::size_t>(ProfileCounter::Count);
+
+        struct ThreadProfile{
+            std::uint64_t Ticks[NumPhases] = {};
+            std::uint64_t Calls[NumPhases] = {};
+            std::uint64_t Counters[NumCounters] = {};
+        };
+
+        // Raw timestamp: the TSC on x86, steady-clock nanoseconds elsewhere
+        static std::uint64_t ticks(){
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        // Profile of the calling thread, registered on first use
+        static ThreadProfile& local(){
+            if (Local == nullptr) Local = registerThread();
+            return *Local;
+        }
+
+        static void addTime(ProfilePhase phase, std::uint64_t elapsed){
+            ThreadProfile& profile = local();
+            profile.Ticks[static_cast<std::size_t>(phase)] += elapsed;
+            ++profile.Calls[static_cast<std::size_t>(phase)];
+        }
+
+        static void count(ProfileCounter counter, std::uint64_t n){
+            local().Counters[static_cast<std::size_t>(counter)] += n;
+        }
+
+        // Sum over every thread that has recorded anything. Call when no workers are running
+        static ThreadProfile totals();
+
+        // Clear all profiles. Call when no workers are running
+        static void reset();
+
+        // Number of profiles allocated; slots of exited threads are reused
+        static std::size_t threadCount();
+
+        // Timestamp ticks per second, measured once against the steady clock
+        static double ticksPerSecond();
+
+        // Print time per phase and the counters
+        static void report(std::ostream& out);
+
+        static const char* phaseName(ProfilePhase phase);
+        static const char* counterName(ProfileCounter counter);
+
+    private:
+        static ThreadProfile* registerThread();
+        static void releaseThread(ThreadProfile* profile);
+
+        static inline thread_local ThreadProfile* Local = nullptr;
+
+        // Hands the slot back when its thread exits, keeping the totals
+        struct Release{
+            ThreadProfile* Profile = nullptr;
+            ~Release(){ if (Profile != nullptr) releaseThread(Profile); }
+        };
+        static thread_local Release Releaser;
+
+        static inline std::mutex Mutex;
+        static inline std::vector<std::unique_ptr<ThreadProfile>> Profiles;
+        static inline std::vector<ThreadProfile*> FreeProfiles;
+};
+
+// Adds the time between construction and destruction to a phase
+class ScopedTimer{
+    private:
+        ProfilePhase Phase;
+        std::uint64_t Start;
+
+    public:
+        explicit ScopedTimer(ProfilePhase phase) : Phase(phase), Start(Instrumentation::ticks()) {}
+        ~ScopedTimer(){ Instrumentation::addTime(Phase, Instrumentation::ticks() - Start); }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#define IR_PROFILE_CONCAT_(a, b) a##b
+#define IR_PROFILE_CONCAT(a, b) IR_PROFILE_CONCAT_(a, b)
+
+#ifdef IRMODELING_INSTRUMENT
+#define IR_PROFILE_SCOPE(phase) ScopedTimer IR_PROFILE_CONCAT(irProfileScope, __LINE__)(ProfilePhase::phase)
+#define IR_COUNT(counter, n) Instrumentation::count(ProfileCounter::counter, static_cast<std::uint64_t>(n))
+#else
+#define IR_PROFILE_SCOPE(phase) ((void)0)
+#define IR_COUNT(counter, n) ((void)0)
+#endif
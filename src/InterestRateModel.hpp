@@ -1,7 +1,10 @@
 #pragma once
 #include <cmath>
+#include <memory>
 #include <random>
 
+class YieldCurve;
+
 // Abstract base class for interest rate models
 class InterestRateModel{
     protected:
@@ -19,7 +22,54 @@ class InterestRateModel{
             distribution = std::normal_distribution<double>(0.0,1.0);
         }
 
+        virtual ~InterestRateModel() = default;
+
         // Pure virtual function to simulate next interest rate
         virtual double simulateNextRate(double currentRate, double timeStep) = 0;
-};
 
+        // Called by RateSimulator before each new path; time-dependent models restart their clock
+        virtual void startPath(){}
+
+        // Advance a rate from time to time + timeStep given a standard normal draw dw.
+        // Const and RNG-free so one model can be shared by threads using common normals
+        virtual double nextRate(double currentRate, double time, double timeStep, double dw) const = 0;
+
+        // Analytic price at `time` of a zero-coupon bond paying 1 at `maturity`,
+        // given the short rate at `time`
+        virtual double zeroCouponBondPrice(double rate, double time, double maturity) const = 0;
+
+        // Coefficients of dr = drift(r, t) dt + diffusion(r, t) dW, used by the PDE solver
+        virtual double drift(double rate, double) const { return MeanReversion * (LongTermMean - rate); }
+        virtual double diffusion(double, double) const { return Volatility; }
+
+        // Lattice representation used by TrinomialTree: a state x = latticeState(r) that
+        // follows dx = latticeDrift(x, t) dt + latticeVolatility() dW. Gaussian models use x = r
+        virtual double latticeState(double rate) const { return rate; }
+        virtual double latticeRate(double state) const { return state; }
+        virtual double latticeDrift(double state, double) const { return MeanReversion * (LongTermMean - state); }
+        virtual double latticeVolatility() const { return Volatility; }
+
+        // Initial curve the model is fitted to, if any
+        virtual const YieldCurve* initialCurve() const { return nullptr; }
+
+        // Copy of the model with its own generator state
+        virtual std::unique_ptr<InterestRateModel> clone() const = 0;
+
+        // Parameter accessors
+        double getMeanReversion() const { return MeanReversion; }
+        double getLongTermMean() const { return LongTermMean; }
+        double getVolatility() const { return Volatility; }
+
+        // Replace the model parameters (scenario bumps, calibration)
+        void setParameters(double MeanRev, double LTM, double Vol){
+            MeanReversion = MeanRev;
+            LongTermMean = LTM;
+            Volatility = Vol;
+        }
+
+        // Reseed the model's own generator
+        void seed(unsigned int s){
+            generator.seed(s);
+            distribution.reset();
+        }
+};
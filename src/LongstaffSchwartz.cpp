@@ -0,0 +1,277 @@
+#include "LongstaffSchwartz.hpp"
+#include "ParallelFor.hpp"
+#include "RateSimulator.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    // Solve the 3x3 system A c = y by Gaussian elimination with partial pivoting
+    bool solve3(double A[3][3], double y[3], double c[3]){
+        for (int col = 0; col < 3; ++col){
+            int pivot = col;
+            for (int row = col + 1; row < 3; ++row){
+                if (std::fabs(A[row][col]) > std::fabs(A[pivot][col])) pivot = row;
+            }
+            if (std::fabs(A[pivot][col]) < 1e-300){
+                return false;
+            }
+            std::swap(A[col], A[pivot]);
+            std::swap(y[col], y[pivot]);
+            for (int row = col + 1; row < 3; ++row){
+                double factor = A[row][col] / A[col][col];
+                for (int k = col; k < 3; ++k) A[row][k] -= factor * A[col][k];
+                y[row] -= factor * y[col];
+            }
+        }
+        for (int row = 2; row >= 0; --row){
+            double sum = y[row];
+            for (int k = row + 1; k < 3; ++k) sum -= A[row][k] * c[k];
+            c[row] = sum / A[row][row];
+        }
+        return true;
+    }
+}
+
+// Constructor for LongstaffSchwartz class
+LongstaffSchwartz::LongstaffSchwartz(unsigned int numPaths, double timeStep, unsigned int steps, unsigned int seed,
+                                     unsigned int threads, unsigned int blockSize)
+    : NumPaths(numPaths), TimeStep(timeStep), Steps(steps), Threads(resolveThreadCount(threads)),
+      BlockSize(std::max(1u, blockSize)) {
+    RateSimulator simulator;
+    Normals = simulator.generateNormals(NumPaths, Steps, seed);
+    setHugePages(false);
+}
+
+// Map the arenas; they grow on first use to whatever the exercise schedule needs
+void LongstaffSchwartz::setHugePages(bool enable){
+    std::lock_guard<std::mutex> lock(ArenaLock);
+    SliceArena = ScratchArena(static_cast<std::size_t>(NumPaths) * 4 * sizeof(double) + 4096, enable);
+    Arenas.clear();
+    for (unsigned int w = 0; w < Threads; ++w){
+        Arenas.emplace_back(static_cast<std::size_t>(Steps) * sizeof(double) + 4096, enable);
+    }
+}
+
+// Backward induction over the exercise dates
+double LongstaffSchwartz::rollBack(const InterestRateModel& model, double InitialRate, const std::vector<double>& dates,
+                                   const ExerciseValue& exercise) const{
+    const std::size_t E = dates.size();
+    const std::size_t N = NumPaths;
+    if (E == 0 || N == 0){
+        return 0.0;
+    }
+
+    // Rate index of each date; rates[i] is the short rate at (i + 1) * TimeStep
+    std::vector<unsigned int> index(E);
+    for (std::size_t e = 0; e < E; ++e){
+        long i = std::lround(dates[e] / TimeStep) - 1;
+        if (i < 0 || i >= static_cast<long>(Steps)){
+            std::cerr << "Exercise date " << dates[e] << " is outside the simulation grid." << std::endl;
+            return 0.0;
+        }
+        index[e] = static_cast<unsigned int>(i);
+    }
+    const unsigned int needed = index.back() + 1;
+
+    // Forward pass: simulate each path only as far as the last date and keep the slices
+    std::lock_guard<std::mutex> lock(ArenaLock);
+    SliceArena.reset();
+    double* rates = SliceArena.allocate<double>(E * N);
+    double* discounts = SliceArena.allocate<double>(E * N);
+    double* exercises = SliceArena.allocate<double>(E * N);
+    std::size_t numBlocks = (N + BlockSize - 1) / BlockSize;
+    RateSimulator simulator;
+
+    parallelFor(numBlocks, Threads, [&](std::size_t b, unsigned int worker){
+        ArenaScope scope(Arenas[worker]);
+        double* path = Arenas[worker].allocate<double>(needed);
+        std::size_t first = b * BlockSize;
+        std::size_t last = std::min(N, first + BlockSize);
+        TraceScope trace("simulate block", "generate", static_cast<std::int64_t>(last - first));
+        for (std::size_t p = first; p < last; ++p){
+            simulator.simulatePathBlock(model, InitialRate, TimeStep, needed, Normals.data() + p * Steps, 1, path);
+
+            // Trapezoidal integral of the short rate from time 0
+            double integral = 0.5 * InitialRate;
+            unsigned int i = 0;
+            for (std::size_t e = 0; e < E; ++e){
+                for (; i < index[e]; ++i){
+                    integral += path[i];
+                }
+                double r = path[index[e]];
+                rates[e * N + p] = r;
+                discounts[e * N + p] = std::exp(-(integral + 0.5 * r) * TimeStep);
+                exercises[e * N + p] = exercise(e, r);
+            }
+        }
+    });
+
+    // Discounted (to time 0) cash flow of the current policy along each path
+    double* value = SliceArena.allocate<double>(N);
+    std::fill(value, value + N, 0.0);
+    std::vector<double> partial(numBlocks * 8);
+
+    for (std::size_t e = E; e-- > 0;){
+        const double* r = &rates[e * N];
+        const double* d = &discounts[e * N];
+        const double* x = &exercises[e * N];
+
+        if (e + 1 == E){
+            // Nothing left to continue into on the last date
+            for (std::size_t p = 0; p < N; ++p){
+                if (x[p] > 0.0) value[p] = x[p] * d[p];
+            }
+            continue;
+        }
+
+        // Mean and spread of the in-the-money rates, to centre and scale the basis
+        std::fill(partial.begin(), partial.end(), 0.0);
+        parallelFor(numBlocks, Threads, [&](std::size_t b, unsigned int){
+            double* sums = &partial[b * 8];
+            std::size_t last = std::min(N, (b + 1) * BlockSize);
+            TraceScope trace("basis moments", "reduction", static_cast<std::int64_t>(last - b * BlockSize));
+            for (std::size_t p = b * BlockSize; p < last; ++p){
+                if (x[p] > 0.0){
+                    sums[0] += 1.0;
+                    sums[1] += r[p];
+                    sums[2] += r[p] * r[p];
+                }
+            }
+        });
+        double count = 0.0, sumR = 0.0, sumR2 = 0.0;
+        for (std::size_t b = 0; b < numBlocks; ++b){
+            count += partial[b * 8];
+            sumR += partial[b * 8 + 1];
+            sumR2 += partial[b * 8 + 2];
+        }
+        if (count < 3.0){
+            continue;
+        }
+        double centre = sumR / count;
+        double spread = std::sqrt(std::max(sumR2 / count - centre * centre, 0.0));
+        double scale = spread > 0.0 ? 1.0 / spread : 1.0;
+
+        // Normal equations: sums of x^0..x^4 and of y x^0..x^2 per block
+        std::fill(partial.begin(), partial.end(), 0.0);
+        parallelFor(numBlocks, Threads, [&](std::size_t b, unsigned int){
+            double* sums = &partial[b * 8];
+            std::size_t last = std::min(N, (b + 1) * BlockSize);
+            TraceScope trace("regression sums", "reduction", static_cast<std::int64_t>(last - b * BlockSize));
+            for (std::size_t p = b * BlockSize; p < last; ++p){
+                if (x[p] > 0.0){
+                    double z = (r[p] - centre) * scale;
+                    double z2 = z * z;
+                    double y = value[p] / d[p];
+                    sums[0] += 1.0;
+                    sums[1] += z;
+                    sums[2] += z2;
+                    sums[3] += z2 * z;
+                    sums[4] += z2 * z2;
+                    sums[5] += y;
+                    sums[6] += y * z;
+                    sums[7] += y * z2;
+                }
+            }
+        });
+        double s[8] = {0.0};
+        for (std::size_t b = 0; b < numBlocks; ++b){
+            for (int k = 0; k < 8; ++k) s[k] += partial[b * 8 + k];
+        }
+        double A[3][3] = {{s[0], s[1], s[2]}, {s[1], s[2], s[3]}, {s[2], s[3], s[4]}};
+        double y[3] = {s[5], s[6], s[7]};
+        double c[3];
+        if (!solve3(A, y, c)){
+            continue;
+        }
+
+        // Exercise where the immediate value beats the estimated continuation
+        parallelFor(numBlocks, Threads, [&](std::size_t b, unsigned int){
+            std::size_t last = std::min(N, (b + 1) * BlockSize);
+            TraceScope trace("exercise policy", "pricing", static_cast<std::int64_t>(last - b * BlockSize));
+            for (std::size_t p = b * BlockSize; p < last; ++p){
+                if (x[p] > 0.0){
+                    double z = (r[p] - centre) * scale;
+                    double continuation = c[0] + z * (c[1] + z * c[2]);
+                    if (x[p] > continuation) value[p] = x[p] * d[p];
+                }
+            }
+        });
+    }
+
+    // Average in block order
+    TraceScope trace("reduce", "reduction", static_cast<std::int64_t>(N));
+    double total = 0.0;
+    for (std::size_t b = 0; b < numBlocks; ++b){
+        double sum = 0.0;
+        std::size_t last = std::min(N, (b + 1) * BlockSize);
+        for (std::size_t p = b * BlockSize; p < last; ++p){
+            sum += value[p];
+        }
+        total += sum;
+    }
+    return total / N;
+}
+
+// Price of a Bermudan swaption
+double LongstaffSchwartz::priceBermudanSwaption(const InterestRateModel& model, double InitialRate,
+                                                const std::vector<double>& exerciseDates, double swapEnd, double fixedRate,
+                                                double frequency, double notional, bool isPayer) const{
+    if (frequency <= 0){
+        std::cerr << "Payment frequency must be positive." << std::endl;
+        return 0.0;
+    }
+    std::vector<double> dates;
+    for (double t : exerciseDates){
+        if (t < swapEnd) dates.push_back(t);
+    }
+    std::sort(dates.begin(), dates.end());
+
+    // Fixed payment dates counted back from the end of the swap
+    std::vector<double> payments;
+    for (double t = swapEnd; t > 1e-12; t -= 1.0 / frequency){
+        payments.push_back(t);
+    }
+    double coupon = fixedRate / frequency;
+
+    auto exercise = [&](std::size_t e, double r){
+        double t = dates[e];
+        double fixedBond = model.zeroCouponBondPrice(r, t, swapEnd);
+        for (double pay : payments){
+            if (pay > t + 1e-9) fixedBond += coupon * model.zeroCouponBondPrice(r, t, pay);
+        }
+        double swapValue = isPayer ? 1.0 - fixedBond : fixedBond - 1.0;
+        return notional * std::max(swapValue, 0.0);
+    };
+    return rollBack(model, InitialRate, dates, exercise);
+}
+
+// Price of a callable bond
+double LongstaffSchwartz::priceCallableBond(const InterestRateModel& model, double InitialRate, const Bond& bond,
+                                            const std::vector<double>& callDates, double callPrice) const{
+    std::vector<CashFlow> flows = bond.cashFlows();
+    double straight = 0.0;
+    double maturity = 0.0;
+    for (const CashFlow& cf : flows){
+        straight += cf.Amount * model.zeroCouponBondPrice(InitialRate, 0.0, cf.Time);
+        maturity = std::max(maturity, cf.Time);
+    }
+
+    std::vector<double> dates;
+    for (double t : callDates){
+        if (t < maturity) dates.push_back(t);
+    }
+    std::sort(dates.begin(), dates.end());
+
+    // Issuer calls when the remaining (ex-coupon) bond is worth more than the call price
+    auto exercise = [&](std::size_t e, double r){
+        double t = dates[e];
+        double remaining = 0.0;
+        for (const CashFlow& cf : flows){
+            if (cf.Time > t + 1e-9) remaining += cf.Amount * model.zeroCouponBondPrice(r, t, cf.Time);
+        }
+        return std::max(remaining - callPrice, 0.0);
+    };
+    return straight - rollBack(model, InitialRate, dates, exercise);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "InterestRateModel.hpp"
+#include "Bond.hpp"
+#include "ScratchArena.hpp"
+
+// Class for least-squares Monte Carlo pricing of early exercise. Paths come from
+// RateSimulator on shared normals, but only the exercise-date slices (short rate, discount
+// factor from time 0 and exercise value) are kept, stored date-major so each backward
+// step streams contiguous arrays. Continuation values are regressed on {1, x, x^2} with
+// x the centred short rate, over in-the-money paths, using per-block normal equations
+// reduced in a fixed order so results do not depend on the thread count. The slices and
+// the per-worker path buffers live in scratch arenas that are kept between pricings
+class LongstaffSchwartz{
+    private:
+        unsigned int NumPaths;
+        double TimeStep;
+        unsigned int Steps;
+        unsigned int Threads;
+        unsigned int BlockSize;
+        std::vector<double> Normals;
+
+        // Date slices, and one path buffer arena per worker; pricings on one engine take turns
+        mutable ScratchArena SliceArena;
+        mutable std::vector<ScratchArena> Arenas;
+        mutable std::mutex ArenaLock;
+
+        // Exercise value at exercise date index e given the short rate on that date
+        typedef std::function<double(std::size_t, double)> ExerciseValue;
+
+        double rollBack(const InterestRateModel& model, double InitialRate, const std::vector<double>& dates,
+                        const ExerciseValue& exercise) const;
+
+    public:
+        // Constructor for LongstaffSchwartz class; threads = 0 uses all cores
+        LongstaffSchwartz(unsigned int numPaths, double timeStep, unsigned int steps, unsigned int seed,
+                          unsigned int threads = 0, unsigned int blockSize = 256);
+
+        // Back the slice and worker arenas with huge pages
+        void setHugePages(bool enable);
+
+        // Price of a Bermudan swaption with the same conventions as TrinomialTree
+        double priceBermudanSwaption(const InterestRateModel& model, double InitialRate,
+                                     const std::vector<double>& exerciseDates, double swapEnd, double fixedRate,
+                                     double frequency, double notional, bool isPayer) const;
+
+        // Price of a bond the issuer may redeem at callPrice on any of callDates: the straight
+        // bond from the model's zero-coupon prices less the issuer's Bermudan call
+        double priceCallableBond(const InterestRateModel& model, double InitialRate, const Bond& bond,
+                                 const std::vector<double>& callDates, double callPrice) const;
+};
@@ -0,0 +1,214 @@
+#include "ModelCalibrator.hpp"
+#include "Dual.hpp"
+#include "ParallelFor.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+using ParamDual = Dual<3>;
+
+// Quotes per parallel work item; small problems stay on one thread
+const std::size_t RowsPerTask = 64;
+
+// Solve the 3x3 system A x = b by Gaussian elimination with partial pivoting
+bool solve3(double A[3][3], double b[3], double x[3]){
+    for (int c = 0; c < 3; ++c){
+        int pivot = c;
+        for (int r = c + 1; r < 3; ++r){
+            if (std::fabs(A[r][c]) > std::fabs(A[pivot][c])) pivot = r;
+        }
+        if (std::fabs(A[pivot][c]) < 1e-300) return false;
+        std::swap(A[c], A[pivot]);
+        std::swap(b[c], b[pivot]);
+        for (int r = c + 1; r < 3; ++r){
+            double m = A[r][c] / A[c][c];
+            for (int k = c; k < 3; ++k) A[r][k] -= m * A[c][k];
+            b[r] -= m * b[c];
+        }
+    }
+    for (int r = 2; r >= 0; --r){
+        double sum = b[r];
+        for (int k = r + 1; k < 3; ++k) sum -= A[r][k] * x[k];
+        x[r] = sum / A[r][r];
+    }
+    return true;
+}
+
+}
+
+// Constructor for ModelCalibrator class
+ModelCalibrator::ModelCalibrator(unsigned int threads, unsigned int maxIterations, double tolerance)
+    : Threads(resolveThreadCount(threads)), MaxIterations(maxIterations), Tolerance(tolerance), Lambda(1e-3) {}
+
+// Add a continuously compounded market zero rate
+void ModelCalibrator::addZeroRate(double maturity, double rate, double weight){
+    if (maturity <= 0){
+        std::cerr << "Zero rate maturity must be positive." << std::endl;
+        return;
+    }
+    Quotes.push_back({{CashFlow{-1, maturity, 1.0}}, rate, weight, true});
+}
+
+// Add a market bond price
+void ModelCalibrator::addBondPrice(const Bond& bond, double price, double weight){
+    if (price <= 0){
+        std::cerr << "Bond price must be positive." << std::endl;
+        return;
+    }
+    Quotes.push_back({bond.cashFlows(), price, weight, false});
+}
+
+// Remove all quotes
+void ModelCalibrator::clearQuotes(){
+    Quotes.clear();
+}
+
+CalibrationResult ModelCalibrator::calibrate(VasicekModel& model, double InitialRate){
+    return fit<VasicekModel>(model, InitialRate);
+}
+
+CalibrationResult ModelCalibrator::calibrate(CIRModel& model, double InitialRate){
+    return fit<CIRModel>(model, InitialRate);
+}
+
+// Levenberg-Marquardt on weighted residuals r_i(a, b, sigma)
+template<class Model>
+CalibrationResult ModelCalibrator::fit(InterestRateModel& model, double InitialRate){
+    CalibrationResult result;
+    std::size_t m = Quotes.size();
+    if (m == 0){
+        std::cerr << "No calibration quotes." << std::endl;
+        return result;
+    }
+
+    if (model.getMeanReversion() <= 0 || model.getVolatility() <= 0){
+        std::cerr << "Starting mean reversion and volatility must be positive." << std::endl;
+        return result;
+    }
+
+    // Work in (log a, b, log sigma) so mean reversion and volatility stay positive
+    double params[3] = {std::log(model.getMeanReversion()), model.getLongTermMean(), std::log(model.getVolatility())};
+    std::vector<double> residuals(m);
+    std::vector<double> trialResiduals(m);
+    std::vector<double> jacobian(m * 3);
+    std::size_t tasks = (m + RowsPerTask - 1) / RowsPerTask;
+
+    // Residuals (and, for accepted points, their exact derivatives), rows split across threads.
+    // Trial points go to a separate buffer so a rejected step leaves the current state intact
+    auto evaluate = [&](const double p[3], bool withJacobian){
+        ParamDual a = exp(ParamDual(p[0], 0));
+        ParamDual b(p[1], 1);
+        ParamDual sigma = exp(ParamDual(p[2], 2));
+        double aValue = std::exp(p[0]);
+        double sigmaValue = std::exp(p[2]);
+        std::vector<double>& out = withJacobian ? residuals : trialResiduals;
+        parallelFor(tasks, Threads, [&](std::size_t task, unsigned int){
+            std::size_t end = std::min(m, (task + 1) * RowsPerTask);
+            TraceScope trace(withJacobian ? "residuals and jacobian" : "residuals", "pricing",
+                             static_cast<std::int64_t>(end - task * RowsPerTask));
+            for (std::size_t i = task * RowsPerTask; i < end; ++i){
+                const Quote& q = Quotes[i];
+                if (withJacobian){
+                    ParamDual value = 0.0;
+                    for (const CashFlow& cf : q.Flows){
+                        value += cf.Amount * Model::zeroCouponBond(a, b, sigma, InitialRate, cf.Time);
+                    }
+                    ParamDual r = q.IsZeroRate ? -log(value) / q.Flows[0].Time - q.Value : value / q.Value - 1.0;
+                    out[i] = q.Weight * r.Value;
+                    for (int k = 0; k < 3; ++k){
+                        jacobian[i * 3 + k] = q.Weight * r.d(k);
+                    }
+                } else {
+                    double value = 0.0;
+                    for (const CashFlow& cf : q.Flows){
+                        value += cf.Amount * Model::zeroCouponBond(aValue, p[1], sigmaValue, InitialRate, cf.Time);
+                    }
+                    double r = q.IsZeroRate ? -std::log(value) / q.Flows[0].Time - q.Value : value / q.Value - 1.0;
+                    out[i] = q.Weight * r;
+                }
+            }
+        });
+        double cost = 0.0;
+        for (double r : out) cost += r * r;
+        return cost;
+    };
+
+    double cost = evaluate(params, true);
+    double lambda = Lambda;
+
+    for (result.Iterations = 0; result.Iterations < MaxIterations; ++result.Iterations){
+        // Normal equations J'J and gradient J'r
+        double JtJ[3][3] = {};
+        double Jtr[3] = {};
+        for (std::size_t i = 0; i < m; ++i){
+            const double* row = &jacobian[i * 3];
+            for (int j = 0; j < 3; ++j){
+                Jtr[j] += row[j] * residuals[i];
+                for (int k = 0; k < 3; ++k) JtJ[j][k] += row[j] * row[k];
+            }
+        }
+
+        double gradNorm = std::max({std::fabs(Jtr[0]), std::fabs(Jtr[1]), std::fabs(Jtr[2])});
+        if (gradNorm < Tolerance || cost < Tolerance * Tolerance){
+            result.Converged = true;
+            break;
+        }
+
+        // Try damped steps until the cost decreases
+        bool improved = false;
+        while (!improved && lambda < 1e12){
+            double A[3][3];
+            double g[3];
+            double delta[3];
+            for (int j = 0; j < 3; ++j){
+                for (int k = 0; k < 3; ++k) A[j][k] = JtJ[j][k];
+                A[j][j] += lambda * std::max(JtJ[j][j], 1e-12);
+                g[j] = -Jtr[j];
+            }
+            if (!solve3(A, g, delta)){
+                lambda *= 10;
+                continue;
+            }
+
+            double trial[3];
+            for (int j = 0; j < 3; ++j) trial[j] = params[j] + delta[j];
+
+            double trialCost = evaluate(trial, false);
+            if (std::isfinite(trialCost) && trialCost < cost){
+                double stepSize = std::max({std::fabs(trial[0] - params[0]), std::fabs(trial[1] - params[1]),
+                                            std::fabs(trial[2] - params[2])});
+                std::copy(trial, trial + 3, params);
+                cost = evaluate(params, true);
+                lambda = std::max(lambda / 10, 1e-12);
+                improved = true;
+                if (stepSize < Tolerance){
+                    result.Converged = true;
+                }
+            } else {
+                lambda *= 10;
+            }
+        }
+        if (!improved){
+            // No descent direction left: at a (possibly flat) minimum
+            result.Converged = true;
+            break;
+        }
+        if (result.Converged){
+            ++result.Iterations;
+            break;
+        }
+    }
+
+    // Remember the damping for the next warm start
+    Lambda = std::max(lambda, 1e-6);
+
+    model.setParameters(std::exp(params[0]), params[1], std::exp(params[2]));
+    result.MeanReversion = model.getMeanReversion();
+    result.LongTermMean = model.getLongTermMean();
+    result.Volatility = model.getVolatility();
+    result.RMSE = std::sqrt(cost / m);
+    return result;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include "Bond.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+
+// Outcome of a calibration run
+struct CalibrationResult{
+    double MeanReversion = 0.0;
+    double LongTermMean = 0.0;
+    double Volatility = 0.0;
+    double RMSE = 0.0;
+    unsigned int Iterations = 0;
+    bool Converged = false;
+};
+
+// Class for fitting Vasicek and CIR parameters to market zero rates and bond prices by
+// Levenberg-Marquardt. Jacobians are exact, from Dual evaluation of the affine bond formulas.
+// Calibration starts from the model's current parameters and writes the fit back, so
+// recalibrating the same model to a moved curve warm-starts from the previous solution
+class ModelCalibrator{
+    private:
+        // Quote expressed as cash flows; zero rates are a single unit flow
+        struct Quote{
+            std::vector<CashFlow> Flows;
+            double Value;
+            double Weight;
+            bool IsZeroRate;
+        };
+
+        std::vector<Quote> Quotes;
+        unsigned int Threads;
+        unsigned int MaxIterations;
+        double Tolerance;
+        double Lambda;
+
+        template<class Model>
+        CalibrationResult fit(InterestRateModel& model, double InitialRate);
+
+    public:
+        // Constructor for ModelCalibrator class; threads = 0 uses all cores
+        ModelCalibrator(unsigned int threads = 1, unsigned int maxIterations = 100, double tolerance = 1e-10);
+
+        // Add a continuously compounded market zero rate
+        void addZeroRate(double maturity, double rate, double weight = 1.0);
+
+        // Add a market bond price (residual is relative to the price)
+        void addBondPrice(const Bond& bond, double price, double weight = 1.0);
+
+        // Remove all quotes, keeping the warm-start state
+        void clearQuotes();
+
+        // Fit the model to the quotes given today's short rate
+        CalibrationResult calibrate(VasicekModel& model, double InitialRate);
+        CalibrationResult calibrate(CIRModel& model, double InitialRate);
+};
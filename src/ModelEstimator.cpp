@@ -0,0 +1,243 @@
+#include "ModelEstimator.hpp"
+#include "ParallelFor.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+const double Pi = 3.14159265358979323846;
+
+bool validPair(double x, double y){
+    return std::isfinite(x) && std::isfinite(y);
+}
+
+// log of the modified Bessel function I_nu(z) for nu > -1, z > 0, without overflow
+double logBesselI(double nu, double z){
+    double absNu = std::fabs(nu);
+
+    if (z <= 600.0){
+        double value = std::cyl_bessel_i(absNu, z);
+        if (nu < 0){
+            // Reflection I_{-v} = I_v + (2/pi) sin(v pi) K_v
+            value += 2.0 / Pi * std::sin(absNu * Pi) * std::cyl_bessel_k(absNu, z);
+        }
+        return std::log(value);
+    }
+
+    if (absNu < 10.0){
+        // Large-argument (Hankel) expansion; K_v is negligible here
+        double mu = 4.0 * nu * nu;
+        double term = 1.0;
+        double sum = 1.0;
+        for (int k = 1; k <= 4; ++k){
+            term *= -(mu - (2.0 * k - 1) * (2.0 * k - 1)) / (8.0 * z * k);
+            sum += term;
+        }
+        return z - 0.5 * std::log(2.0 * Pi * z) + std::log(sum);
+    }
+
+    // Uniform (Debye) expansion for large order
+    double t = z / nu;
+    double s = std::sqrt(1.0 + t * t);
+    double eta = s + std::log(t / (1.0 + s));
+    double p = 1.0 / s;
+    double u1 = (3.0 * p - 5.0 * p * p * p) / 24.0;
+    double u2 = (81.0 * p * p - 462.0 * std::pow(p, 4) + 385.0 * std::pow(p, 6)) / 1152.0;
+    return nu * eta - 0.5 * std::log(2.0 * Pi * nu) - 0.5 * std::log(s)
+            + std::log(1.0 + u1 / nu + u2 / (nu * nu));
+}
+
+// Exact CIR log-likelihood of all valid transitions
+double cirLogLikelihood(const std::vector<double>& rates, double timeStep, double a, double b, double sigma,
+                        unsigned int& count){
+    double decay = std::exp(-a * timeStep);
+    double c = 2.0 * a / (sigma * sigma * (1.0 - decay));
+    double q = 2.0 * a * b / (sigma * sigma) - 1.0;
+
+    double logLik = 0.0;
+    count = 0;
+    for (std::size_t i = 0; i + 1 < rates.size(); ++i){
+        if (!validPair(rates[i], rates[i + 1])) continue;
+        double u = c * std::max(rates[i], 1e-12) * decay;
+        double v = c * std::max(rates[i + 1], 1e-12);
+        logLik += std::log(c) - u - v + 0.5 * q * std::log(v / u) + logBesselI(q, 2.0 * std::sqrt(u * v));
+        ++count;
+    }
+    return logLik;
+}
+
+// Nelder-Mead minimisation of f over three variables
+template<typename F>
+std::array<double, 3> nelderMead(F f, std::array<double, 3> start, double scale, unsigned int maxIterations,
+                                 bool& converged){
+    std::array<std::array<double, 3>, 4> simplex;
+    std::array<double, 4> values;
+    for (int i = 0; i < 4; ++i){
+        simplex[i] = start;
+        if (i > 0) simplex[i][i - 1] += scale;
+        values[i] = f(simplex[i]);
+    }
+
+    converged = false;
+    for (unsigned int it = 0; it < maxIterations; ++it){
+        // Order vertices best to worst
+        std::array<int, 4> order = {0, 1, 2, 3};
+        std::sort(order.begin(), order.end(), [&](int x, int y){ return values[x] < values[y]; });
+        std::array<std::array<double, 3>, 4> s;
+        std::array<double, 4> v;
+        for (int i = 0; i < 4; ++i){ s[i] = simplex[order[i]]; v[i] = values[order[i]]; }
+        simplex = s;
+        values = v;
+
+        if (std::fabs(values[3] - values[0]) < 1e-10 * (1.0 + std::fabs(values[0]))){
+            converged = true;
+            break;
+        }
+
+        std::array<double, 3> centroid = {0.0, 0.0, 0.0};
+        for (int i = 0; i < 3; ++i){
+            for (int k = 0; k < 3; ++k) centroid[k] += simplex[i][k] / 3.0;
+        }
+        auto along = [&](double t){
+            std::array<double, 3> x;
+            for (int k = 0; k < 3; ++k) x[k] = centroid[k] + t * (simplex[3][k] - centroid[k]);
+            return x;
+        };
+
+        std::array<double, 3> reflected = along(-1.0);
+        double fr = f(reflected);
+        if (fr < values[0]){
+            std::array<double, 3> expanded = along(-2.0);
+            double fe = f(expanded);
+            if (fe < fr){ simplex[3] = expanded; values[3] = fe; }
+            else { simplex[3] = reflected; values[3] = fr; }
+        } else if (fr < values[2]){
+            simplex[3] = reflected;
+            values[3] = fr;
+        } else {
+            std::array<double, 3> contracted = fr < values[3] ? along(-0.5) : along(0.5);
+            double fc = f(contracted);
+            if (fc < std::min(fr, values[3])){
+                simplex[3] = contracted;
+                values[3] = fc;
+            } else {
+                // Shrink towards the best vertex
+                for (int i = 1; i < 4; ++i){
+                    for (int k = 0; k < 3; ++k) simplex[i][k] = simplex[0][k] + 0.5 * (simplex[i][k] - simplex[0][k]);
+                    values[i] = f(simplex[i]);
+                }
+            }
+        }
+    }
+
+    int best = static_cast<int>(std::min_element(values.begin(), values.end()) - values.begin());
+    return simplex[best];
+}
+
+}
+
+// Vasicek by AR(1) least squares: r[t+1] = alpha + beta r[t] + eps
+EstimationResult ModelEstimator::estimateVasicek(const std::vector<double>& rates, double timeStep) const{
+    EstimationResult result;
+
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (std::size_t i = 0; i + 1 < rates.size(); ++i){
+        if (!validPair(rates[i], rates[i + 1])) continue;
+        double x = rates[i];
+        double y = rates[i + 1];
+        n += 1; sx += x; sy += y; sxx += x * x; sxy += x * y;
+    }
+    if (n < 3){
+        std::cerr << "Not enough observations for Vasicek estimation." << std::endl;
+        return result;
+    }
+
+    double beta = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    double alpha = (sy - beta * sx) / n;
+    if (!(beta > 0.0 && beta < 1.0)){
+        std::cerr << "Series is not mean reverting (AR(1) slope " << beta << ")." << std::endl;
+        return result;
+    }
+
+    double ssr = 0.0;
+    for (std::size_t i = 0; i + 1 < rates.size(); ++i){
+        if (!validPair(rates[i], rates[i + 1])) continue;
+        double e = rates[i + 1] - alpha - beta * rates[i];
+        ssr += e * e;
+    }
+    double residualVariance = ssr / n;
+
+    result.MeanReversion = -std::log(beta) / timeStep;
+    result.LongTermMean = alpha / (1.0 - beta);
+    result.Volatility = std::sqrt(residualVariance * 2.0 * result.MeanReversion / (1.0 - beta * beta));
+    result.LogLikelihood = -0.5 * n * (std::log(2.0 * Pi * residualVariance) + 1.0);
+    result.Observations = static_cast<unsigned int>(n);
+    result.Converged = true;
+    return result;
+}
+
+// CIR by exact maximum likelihood
+EstimationResult ModelEstimator::estimateCIR(const std::vector<double>& rates, double timeStep) const{
+    EstimationResult result;
+
+    // Starting point from least squares on the Euler scheme divided by sqrt(r):
+    // dr / sqrt(r) = ab dt / sqrt(r) - a dt sqrt(r) + sigma sqrt(dt) eps
+    double s11 = 0, s12 = 0, s22 = 0, s1y = 0, s2y = 0, n = 0;
+    for (std::size_t i = 0; i + 1 < rates.size(); ++i){
+        if (!validPair(rates[i], rates[i + 1]) || rates[i] <= 0) continue;
+        double root = std::sqrt(rates[i]);
+        double x1 = timeStep / root;
+        double x2 = -timeStep * root;
+        double y = (rates[i + 1] - rates[i]) / root;
+        s11 += x1 * x1; s12 += x1 * x2; s22 += x2 * x2; s1y += x1 * y; s2y += x2 * y; n += 1;
+    }
+    if (n < 3){
+        std::cerr << "Not enough positive observations for CIR estimation." << std::endl;
+        return result;
+    }
+    double det = s11 * s22 - s12 * s12;
+    double ab = (s22 * s1y - s12 * s2y) / det;
+    double a = (s11 * s2y - s12 * s1y) / det;
+    double ssr = 0.0;
+    for (std::size_t i = 0; i + 1 < rates.size(); ++i){
+        if (!validPair(rates[i], rates[i + 1]) || rates[i] <= 0) continue;
+        double root = std::sqrt(rates[i]);
+        double e = (rates[i + 1] - rates[i]) / root - ab * timeStep / root + a * timeStep * root;
+        ssr += e * e;
+    }
+    double sigma = std::sqrt(ssr / n / timeStep);
+    a = std::max(a, 1e-3);
+    double b = std::max(ab / a, 1e-4);
+
+    // Maximise the exact likelihood over (log a, log b, log sigma)
+    auto negLogLik = [&](const std::array<double, 3>& x){
+        unsigned int count = 0;
+        double value = -cirLogLikelihood(rates, timeStep, std::exp(x[0]), std::exp(x[1]), std::exp(x[2]), count);
+        return std::isfinite(value) ? value : std::numeric_limits<double>::max();
+    };
+    bool converged = false;
+    std::array<double, 3> best = nelderMead(negLogLik, {std::log(a), std::log(b), std::log(sigma)}, 0.1, 2000, converged);
+
+    result.MeanReversion = std::exp(best[0]);
+    result.LongTermMean = std::exp(best[1]);
+    result.Volatility = std::exp(best[2]);
+    result.LogLikelihood = cirLogLikelihood(rates, timeStep, result.MeanReversion, result.LongTermMean,
+                                            result.Volatility, result.Observations);
+    result.Converged = converged;
+    return result;
+}
+
+// Fit both models to every series in parallel
+std::vector<SeriesEstimate> ModelEstimator::estimateAll(const RateHistory& history, double timeStep,
+                                                        unsigned int threads) const{
+    std::vector<SeriesEstimate> estimates(history.size());
+    parallelFor(history.size(), threads, [&](std::size_t i, unsigned int){
+        estimates[i].Name = history.name(i);
+        estimates[i].Vasicek = estimateVasicek(history.series(i), timeStep);
+        estimates[i].CIR = estimateCIR(history.series(i), timeStep);
+    });
+    return estimates;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "RateHistory.hpp"
+
+// Parameters estimated from a historical series
+struct EstimationResult{
+    double MeanReversion = 0.0;
+    double LongTermMean = 0.0;
+    double Volatility = 0.0;
+    double LogLikelihood = 0.0;
+    unsigned int Observations = 0;
+    bool Converged = false;
+};
+
+// Vasicek and CIR fits for one series of a history
+struct SeriesEstimate{
+    std::string Name;
+    EstimationResult Vasicek;
+    EstimationResult CIR;
+};
+
+// Class for estimating model parameters from observed short rates sampled every timeStep
+// years. NaN entries are gaps: transitions into or out of a gap are skipped
+class ModelEstimator{
+    public:
+        // Vasicek by closed-form AR(1) least squares (the exact MLE for its Gaussian transition)
+        EstimationResult estimateVasicek(const std::vector<double>& rates, double timeStep) const;
+
+        // CIR by maximising the exact non-central chi-square transition likelihood,
+        // started from the discretised least-squares estimate
+        EstimationResult estimateCIR(const std::vector<double>& rates, double timeStep) const;
+
+        // Fit both models to every series in parallel; threads = 0 uses all cores
+        std::vector<SeriesEstimate> estimateAll(const RateHistory& history, double timeStep,
+                                                unsigned int threads = 0) const;
+};
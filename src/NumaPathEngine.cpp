@@ -0,0 +1,152 @@
+#include "NumaPathEngine.hpp"
+#include "RateSimulator.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+// Constructor for NumaPathEngine class
+NumaPathEngine::NumaPathEngine(const NumaTopology& topology, unsigned int threadsPerNode,
+                               unsigned int blockSize, bool pin)
+    : Topology(topology), ThreadsPerNode(threadsPerNode), BlockSize(std::max(1u, blockSize)), Pin(pin),
+      TimeStep(0.0), Steps(0), NumPaths(0), NumBlocks(0), FirstBlock(topology.numNodes() + 1, 0), PinFailures(0) {}
+
+unsigned int NumaPathEngine::nodeThreads(std::size_t node) const{
+    unsigned int cpus = static_cast<unsigned int>(Topology.node(node).Cpus.size());
+    return ThreadsPerNode > 0 ? ThreadsPerNode : std::max(1u, cpus);
+}
+
+// Mix the block index into the seed so neighbouring blocks get unrelated streams
+unsigned int NumaPathEngine::blockSeed(unsigned int seed, std::size_t block){
+    std::uint64_t x = (static_cast<std::uint64_t>(seed) << 32) ^ (block + 0x9E3779B97F4A7C15ull);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<unsigned int>(x ^ (x >> 31));
+}
+
+void NumaPathEngine::forEachBlock(const std::function<void(std::size_t, ScratchArena&)>& blockFn,
+                                  const std::function<void(std::size_t)>& nodeDone) const{
+    std::size_t nodes = Topology.numNodes();
+    std::unique_ptr<std::atomic<std::size_t>[]> next(new std::atomic<std::size_t>[nodes]);
+    std::unique_ptr<std::atomic<unsigned int>[]> finished(new std::atomic<unsigned int>[nodes]);
+    for (std::size_t n = 0; n < nodes; ++n){
+        next[n] = FirstBlock[n];
+        finished[n] = 0;
+    }
+
+    std::vector<std::thread> pool;
+    for (std::size_t n = 0; n < nodes; ++n){
+        unsigned int threads = nodeThreads(n);
+        for (unsigned int t = 0; t < threads; ++t){
+            pool.emplace_back([&, n, threads]{
+                if (Pin && !NumaTopology::pinCurrentThread(Topology.node(n).Cpus)){
+                    ++PinFailures;
+                }
+                // Scratch is mapped here so it is local to the worker's node
+                ScratchArena scratch(static_cast<std::size_t>(BlockSize) * Steps * sizeof(double) + 4096);
+                for (std::size_t b = next[n]++; b < FirstBlock[n + 1]; b = next[n]++){
+                    ArenaScope scope(scratch);
+                    blockFn(b, scratch);
+                }
+                if (finished[n].fetch_add(1) + 1 == threads){
+                    nodeDone(n);
+                }
+            });
+        }
+    }
+    for (std::thread& t : pool){
+        t.join();
+    }
+}
+
+// Lay out the partitions, then let each node's workers fill their own blocks
+void NumaPathEngine::simulate(const InterestRateModel& model, double InitialRate, double timeStep,
+                              unsigned int steps, unsigned int numPaths, unsigned int seed){
+    TimeStep = timeStep;
+    Steps = steps;
+    NumPaths = numPaths;
+    NumBlocks = (NumPaths + BlockSize - 1) / BlockSize;
+
+    // Blocks in proportion to each node's workers
+    std::size_t nodes = Topology.numNodes();
+    std::size_t totalThreads = 0;
+    for (std::size_t n = 0; n < nodes; ++n) totalThreads += nodeThreads(n);
+    std::size_t assigned = 0;
+    for (std::size_t n = 0; n < nodes; ++n){
+        assigned += nodeThreads(n);
+        FirstBlock[n + 1] = NumBlocks * assigned / totalThreads;
+    }
+
+    // Reserve address space only; no page is touched until a worker writes its block
+    Partitions.clear();
+    BlockRates.assign(NumBlocks, nullptr);
+    for (std::size_t n = 0; n < nodes; ++n){
+        std::size_t values = static_cast<std::size_t>(nodeBlocks(n)) * BlockSize * Steps;
+        Partitions.emplace_back(values * sizeof(double) + nodeBlocks(n) * 64 + 4096);
+        for (std::size_t b = FirstBlock[n]; b < FirstBlock[n + 1]; ++b){
+            BlockRates[b] = Partitions[n].allocate<double>(static_cast<std::size_t>(BlockSize) * Steps);
+        }
+    }
+
+    RateSimulator simulator;
+    forEachBlock([&](std::size_t b, ScratchArena& scratch){
+        unsigned int first = static_cast<unsigned int>(b * BlockSize);
+        unsigned int paths = static_cast<unsigned int>(std::min<std::size_t>(BlockSize, NumPaths - first));
+        TraceScope trace("simulate block", "generate", paths);
+        double* normals = scratch.allocate<double>(static_cast<std::size_t>(paths) * Steps);
+        simulator.generateNormals(paths, Steps, blockSeed(seed, b), normals);
+        simulator.simulatePathBlock(model, InitialRate, TimeStep, Steps, normals, paths, BlockRates[b]);
+    }, [](std::size_t){});
+}
+
+// Block sums, reduced on each node and then across nodes
+std::vector<double> NumaPathEngine::price(const std::vector<Bond>& bonds, const std::vector<SwaptionTrade>& swaptions) const{
+    std::size_t numInstruments = bonds.size() + swaptions.size();
+    std::vector<std::vector<CashFlow>> schedules;
+    for (const Bond& bond : bonds){
+        schedules.push_back(bond.cashFlowSchedule(TimeStep, Steps));
+    }
+
+    std::vector<double> partial(NumBlocks * numInstruments, 0.0);
+    std::vector<double> nodeTotals(Topology.numNodes() * numInstruments, 0.0);
+
+    forEachBlock([&](std::size_t b, ScratchArena&){
+        unsigned int first = static_cast<unsigned int>(b * BlockSize);
+        unsigned int paths = static_cast<unsigned int>(std::min<std::size_t>(BlockSize, NumPaths - first));
+        TraceScope trace("price block", "pricing", paths);
+        double* sums = partial.data() + b * numInstruments;
+        for (unsigned int p = 0; p < paths; ++p){
+            const double* rates = BlockRates[b] + static_cast<std::size_t>(p) * Steps;
+            for (std::size_t k = 0; k < bonds.size(); ++k){
+                sums[k] += Bond::price(rates, schedules[k]);
+            }
+            for (std::size_t k = 0; k < swaptions.size(); ++k){
+                const SwaptionTrade& trade = swaptions[k];
+                sums[bonds.size() + k] += trade.Instrument.price(rates, Steps, trade.Volatility, TimeStep, trade.Frequency, trade.IsPayer);
+            }
+        }
+    }, [&](std::size_t n){
+        TraceScope trace("node reduce", "reduction", static_cast<std::int64_t>(nodeBlocks(n)));
+        double* totals = nodeTotals.data() + n * numInstruments;
+        for (std::size_t b = FirstBlock[n]; b < FirstBlock[n + 1]; ++b){
+            for (std::size_t k = 0; k < numInstruments; ++k){
+                totals[k] += partial[b * numInstruments + k];
+            }
+        }
+    });
+
+    std::vector<double> prices(numInstruments, 0.0);
+    for (std::size_t n = 0; n < Topology.numNodes(); ++n){
+        for (std::size_t k = 0; k < numInstruments; ++k){
+            prices[k] += nodeTotals[n * numInstruments + k];
+        }
+    }
+    for (double& price : prices){
+        price = NumPaths == 0 ? 0.0 : price / NumPaths;
+    }
+    return prices;
+}
+
+const double* NumaPathEngine::path(std::size_t p) const{
+    return BlockRates[p / BlockSize] + (p % BlockSize) * Steps;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "NumaTopology.hpp"
+#include "ScratchArena.hpp"
+#include "ScenarioEngine.hpp"
+
+// NUMA-aware Monte Carlo engine. Path blocks are split between nodes in proportion to
+// their worker counts; each node's workers are pinned to that node's CPUs and are the
+// first to write its partition of the path matrix, so the pages are allocated locally
+// and later pricing passes stream from local memory. Block sums are reduced per node on
+// that node, then across nodes in node order. Each block draws its normals from its own
+// seed, so the paths do not depend on the node or thread layout
+class NumaPathEngine{
+    private:
+        NumaTopology Topology;
+        unsigned int ThreadsPerNode;
+        unsigned int BlockSize;
+        bool Pin;
+
+        double TimeStep;
+        unsigned int Steps;
+        std::size_t NumPaths;
+        std::size_t NumBlocks;
+        std::vector<std::size_t> FirstBlock;      // node n owns blocks [FirstBlock[n], FirstBlock[n + 1])
+        std::vector<ScratchArena> Partitions;     // one per node, touched first by its workers
+        std::vector<double*> BlockRates;
+        mutable std::atomic<unsigned int> PinFailures;
+
+        unsigned int nodeThreads(std::size_t node) const;
+
+        // Run blockFn(block, scratch) for every block on its node's workers, then
+        // nodeDone(node) on the last of that node's workers to finish
+        void forEachBlock(const std::function<void(std::size_t, ScratchArena&)>& blockFn,
+                          const std::function<void(std::size_t)>& nodeDone) const;
+
+    public:
+        // Constructor for NumaPathEngine class; threadsPerNode = 0 uses every CPU of each node
+        NumaPathEngine(const NumaTopology& topology, unsigned int threadsPerNode = 0,
+                       unsigned int blockSize = 256, bool pin = true);
+
+        // Simulate numPaths paths into the node partitions, replacing any stored paths
+        void simulate(const InterestRateModel& model, double InitialRate, double timeStep,
+                      unsigned int steps, unsigned int numPaths, unsigned int seed);
+
+        // Mean price of each bond, then each swaption, over the stored paths
+        std::vector<double> price(const std::vector<Bond>& bonds, const std::vector<SwaptionTrade>& swaptions) const;
+
+        // Stored path p (steps rates)
+        const double* path(std::size_t p) const;
+
+        std::size_t numPaths() const { return NumPaths; }
+        unsigned int steps() const { return Steps; }
+        std::size_t numNodes() const { return Topology.numNodes(); }
+        std::size_t nodeBlocks(std::size_t node) const { return FirstBlock[node + 1] - FirstBlock[node]; }
+
+        // Workers whose CPU affinity could not be set (they still run, unpinned)
+        unsigned int pinFailures() const { return PinFailures.load(); }
+
+        // Seed for the normals of block b
+        static unsigned int blockSeed(unsigned int seed, std::size_t block);
+};
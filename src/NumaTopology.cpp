@@ -0,0 +1,100 @@
+#include "NumaTopology.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+
+// Constructor for NumaTopology class
+NumaTopology::NumaTopology(std::vector<NumaNode> nodes) : Nodes(std::move(nodes)) {
+    if (Nodes.empty()){
+        Nodes.push_back({0, allowedCpus()});
+    }
+}
+
+// Parse "0-3,8-11" style lists
+std::vector<int> NumaTopology::parseCpuList(const std::string& list){
+    std::vector<int> cpus;
+    std::size_t pos = 0;
+    while (pos < list.size()){
+        std::size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        std::string item = list.substr(pos, end - pos);
+        std::size_t dash = item.find('-');
+        if (!item.empty() && item.find_first_of("0123456789") != std::string::npos){
+            int first = std::atoi(item.c_str());
+            int last = dash == std::string::npos ? first : std::atoi(item.c_str() + dash + 1);
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+std::vector<int> NumaTopology::allowedCpus(){
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0){
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu){
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()){
+        unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int cpu = 0; cpu < count; ++cpu) cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+// Read every nodeN/cpulist under root, keeping CPUs the process may use
+NumaTopology NumaTopology::detect(const std::string& root){
+    std::vector<int> allowed = allowedCpus();
+    std::vector<NumaNode> nodes;
+
+    DIR* dir = opendir(root.c_str());
+    if (dir != nullptr){
+        while (dirent* entry = readdir(dir)){
+            std::string name = entry->d_name;
+            if (name.size() < 5 || name.compare(0, 4, "node") != 0
+                || name.find_first_not_of("0123456789", 4) != std::string::npos){
+                continue;
+            }
+            std::ifstream file(root + "/" + name + "/cpulist");
+            std::string list;
+            std::getline(file, list);
+
+            NumaNode node{std::atoi(name.c_str() + 4), {}};
+            for (int cpu : parseCpuList(list)){
+                if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) node.Cpus.push_back(cpu);
+            }
+            if (!node.Cpus.empty()) nodes.push_back(node);
+        }
+        closedir(dir);
+    }
+
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b){ return a.Id < b.Id; });
+    return NumaTopology(nodes);
+}
+
+NumaTopology NumaTopology::restrict(std::size_t maxNodes) const{
+    std::size_t count = std::max<std::size_t>(1, std::min(maxNodes, Nodes.size()));
+    return NumaTopology(std::vector<NumaNode>(Nodes.begin(), Nodes.begin() + count));
+}
+
+std::size_t NumaTopology::numCpus() const{
+    std::size_t count = 0;
+    for (const NumaNode& node : Nodes) count += node.Cpus.size();
+    return count;
+}
+
+bool NumaTopology::pinCurrentThread(const std::vector<int>& cpus){
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus){
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// A NUMA node and the CPUs on it that this process may run on
+struct NumaNode{
+    int Id;
+    std::vector<int> Cpus;
+};
+
+// Machine layout read from sysfs. Nodes without usable CPUs (memory-only nodes, or CPUs
+// outside the process affinity mask) are left out; a machine without NUMA information
+// is one node holding every allowed CPU
+class NumaTopology{
+    private:
+        std::vector<NumaNode> Nodes;
+
+    public:
+        // Constructor for NumaTopology class
+        explicit NumaTopology(std::vector<NumaNode> nodes);
+
+        // Read /sys/devices/system/node (or a copy of it under root)
+        static NumaTopology detect(const std::string& root = "/sys/devices/system/node");
+
+        // The first maxNodes nodes, e.g. to compare one socket with two
+        NumaTopology restrict(std::size_t maxNodes) const;
+
+        std::size_t numNodes() const { return Nodes.size(); }
+        const NumaNode& node(std::size_t i) const { return Nodes[i]; }
+        std::size_t numCpus() const;
+
+        // Parse a sysfs CPU list such as "0-3,8-11"
+        static std::vector<int> parseCpuList(const std::string& list);
+
+        // Restrict the calling thread to the given CPUs; false if the system refuses
+        static bool pinCurrentThread(const std::vector<int>& cpus);
+
+        // CPUs the process may run on
+        static std::vector<int> allowedCpus();
+};
@@ -0,0 +1,29 @@
+#include "ObservationSchedule.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+#include <iostream>
+
+// Constructor for ObservationSchedule class
+ObservationSchedule::ObservationSchedule(const TimeGrid& grid, const std::vector<double>& dates, bool integrals)
+    : Integrals(integrals) {
+    std::vector<double> onGrid;
+    for (double t : dates){
+        if (grid.index(t) < 0){
+            std::cerr << "Error: Observation date " << t << " is not a node of the time grid." << std::endl;
+            continue;
+        }
+        onGrid.push_back(t);
+    }
+
+    // Sorted and merged like any grid, then mapped back to the fine nodes
+    Observed = TimeGrid(onGrid);
+    for (double t : Observed.times()){
+        Nodes.push_back(static_cast<std::size_t>(grid.index(t)));
+    }
+}
+
+// Observe every date the instruments are priced off
+ObservationSchedule ObservationSchedule::forInstruments(const TimeGrid& grid, const std::vector<Bond>& bonds,
+                                                        const std::vector<Swaption>& swaptions, bool integrals){
+    return ObservationSchedule(grid, TimeGrid::forInstruments(bonds, swaptions).times(), integrals);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "TimeGrid.hpp"
+
+class Bond;
+class Swaption;
+
+// The nodes of a simulation grid whose rates are kept. Paths are still stepped on every
+// node of the fine grid, but only the observed slices are stored, optionally with the
+// running trapezoidal integral of the short rate from time 0 to each observation (for
+// discount factors and swap-period averages). The observed dates form a grid of their
+// own, so instruments compile their schedules against dates() and index the slices
+class ObservationSchedule{
+    private:
+        TimeGrid Observed;
+        std::vector<std::size_t> Nodes;
+        bool Integrals;
+
+    public:
+        // Constructor for ObservationSchedule class; dates that are not nodes of grid are
+        // reported and dropped
+        ObservationSchedule(const TimeGrid& grid, const std::vector<double>& dates, bool integrals = false);
+
+        // Cash-flow dates of the bonds and exercise and swap end dates of the swaptions
+        static ObservationSchedule forInstruments(const TimeGrid& grid, const std::vector<Bond>& bonds,
+                                                  const std::vector<Swaption>& swaptions, bool integrals = false);
+
+        std::size_t size() const { return Nodes.size(); }
+
+        // Fine-grid node of observation k
+        std::size_t node(std::size_t k) const { return Nodes[k]; }
+
+        const TimeGrid& dates() const { return Observed; }
+        bool integrals() const { return Integrals; }
+};
+
+// Observed slices of a block of paths, path-major with size() entries per path;
+// Integrals is empty unless the schedule asked for it
+struct ObservedPaths{
+    std::vector<double> Rates;
+    std::vector<double> Integrals;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Number of worker threads to use when the caller asks for 0 (= all cores)
+inline unsigned int resolveThreadCount(unsigned int threads){
+    if (threads == 0){
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+// Run fn(index, worker) for every index in [0, count) on up to `threads` workers.
+// Indices are handed out dynamically so uneven work items balance across workers;
+// worker is in [0, threads) and can be used to address per-thread scratch space.
+template<typename Fn>
+void parallelFor(std::size_t count, unsigned int threads, Fn fn){
+    threads = resolveThreadCount(threads);
+    if (threads > count){
+        threads = count == 0 ? 1 : static_cast<unsigned int>(count);
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto work = [&](unsigned int worker){
+        for (std::size_t i = next++; i < count; i = next++){
+            fn(i, worker);
+        }
+    };
+
+    if (threads == 1){
+        work(0);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned int w = 1; w < threads; ++w){
+        pool.emplace_back(work, w);
+    }
+    work(0);
+    for (std::thread& t : pool){
+        t.join();
+    }
+}
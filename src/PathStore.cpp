@@ -0,0 +1,245 @@
+#include "PathStore.hpp"
+#include "RateSimulator.hpp"
+#include "Instrumentation.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const char PathMagic[8] = {'I', 'R', 'P', 'A', 'T', 'H', 'S', '\0'};
+    const std::uint32_t PathVersion = 2;      // version 1 files have no compression fields
+
+    static_assert(sizeof(PathStoreHeader) <= PathStoreHeader::Alignment, "header must fit its padding");
+
+    // Write all of [data, data + length), retrying short writes
+    bool writeAll(int fd, const char* data, std::size_t length){
+        IR_PROFILE_SCOPE(Io);
+        TraceScope trace("write", "io", static_cast<std::int64_t>(length));
+        while (length > 0){
+            ssize_t written = ::write(fd, data, length);
+            if (written <= 0){
+                return false;
+            }
+            data += written;
+            length -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+}
+
+PathStore::~PathStore(){
+    close();
+}
+
+// Simulate and write a path file
+template<typename Real>
+bool PathStore::write(const std::string& filename, const InterestRateModel& model, const std::string& modelName,
+                      double InitialRate, double timeStep, unsigned int steps, unsigned int numPaths,
+                      unsigned int seed, unsigned int blockPaths, PathLayout layout, double tolerance){
+    if (steps == 0 || blockPaths == 0){
+        std::cerr << "Path file needs at least one step and one path per block." << std::endl;
+        return false;
+    }
+    bool compress = tolerance > 0.0;
+    if (compress && layout != PathLayout::PathMajor){
+        std::cerr << "Compressed path files are path-major." << std::endl;
+        return false;
+    }
+    const std::size_t align = PathStoreHeader::Alignment;
+    std::size_t numBlocks = (static_cast<std::size_t>(numPaths) + blockPaths - 1) / blockPaths;
+
+    // Header, padded to the alignment
+    std::vector<char> page(PathStoreHeader::Alignment, 0);
+    PathStoreHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.Magic, PathMagic, sizeof(PathMagic));
+    header.Version = PathVersion;
+    header.Layout = layout;
+    header.ScalarBytes = sizeof(Real);
+    header.Steps = steps;
+    header.NumPaths = numPaths;
+    header.BlockPaths = blockPaths;
+    std::size_t payload = static_cast<std::size_t>(blockPaths) * steps * sizeof(Real);
+    header.BlockBytes = compress ? 0 : (payload + align - 1) / align * align;
+    header.Seed = seed;
+    header.TimeStep = timeStep;
+    header.InitialRate = InitialRate;
+    header.MeanReversion = model.getMeanReversion();
+    header.LongTermMean = model.getLongTermMean();
+    header.Volatility = model.getVolatility();
+    std::strncpy(header.Model, modelName.c_str(), sizeof(header.Model) - 1);
+    header.Tolerance = compress ? tolerance : 0.0;
+    header.IndexOffset = compress ? align : 0;
+    std::memcpy(page.data(), &header, sizeof(header));
+
+    // Compressed blocks vary in size: reserve an index after the header, filled in at the end
+    std::vector<std::uint64_t> index(2 * numBlocks, 0);
+    std::size_t indexBytes = compress ? (index.size() * sizeof(std::uint64_t) + align - 1) / align * align : 0;
+    std::size_t position = align + indexBytes;
+
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0){
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+    bool ok = writeAll(fd, page.data(), page.size());
+    if (compress){
+        std::vector<char> zeros(indexBytes, 0);
+        ok = ok && writeAll(fd, zeros.data(), zeros.size());
+    }
+
+    // One stream of normals across all blocks, as generateNormals would draw them
+    std::default_random_engine generator(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    RateSimulator simulator;
+    std::vector<Real> normals(static_cast<std::size_t>(blockPaths) * steps);
+    std::vector<Real> paths(normals.size());
+    std::vector<char> buffer(header.BlockBytes, 0);
+
+    for (unsigned int first = 0, b = 0; ok && first < numPaths; first += blockPaths, ++b){
+        unsigned int count = std::min(blockPaths, numPaths - first);
+        std::size_t values = static_cast<std::size_t>(count) * steps;
+        {
+            IR_PROFILE_SCOPE(Rng);
+            TraceScope trace("normals", "rng", static_cast<std::int64_t>(values));
+            for (std::size_t i = 0; i < values; ++i){
+                normals[i] = static_cast<Real>(distribution(generator));
+            }
+        }
+        {
+            TraceScope trace("simulate block", "generate", count);
+            simulator.simulatePathBlock(model, InitialRate, timeStep, steps, normals.data(), count, paths.data());
+        }
+
+        if (compress){
+            // Each compressed block starts on an aligned offset
+            CompressedPathBlock encoded;
+            {
+                TraceScope trace("compress block", "io", count);
+                encoded = CompressedPathBlock::encode(paths.data(), count, steps, tolerance);
+            }
+            std::size_t padded = (encoded.size() + align - 1) / align * align;
+            index[2 * b] = position;
+            index[2 * b + 1] = encoded.size();
+            buffer.assign(padded, 0);
+            std::memcpy(buffer.data(), encoded.data(), encoded.size());
+            ok = writeAll(fd, buffer.data(), buffer.size());
+            position += padded;
+            continue;
+        }
+
+        Real* out = reinterpret_cast<Real*>(buffer.data());
+        if (layout == PathLayout::StepMajor){
+            for (unsigned int p = 0; p < count; ++p){
+                for (unsigned int i = 0; i < steps; ++i){
+                    out[static_cast<std::size_t>(i) * count + p] = paths[static_cast<std::size_t>(p) * steps + i];
+                }
+            }
+        } else {
+            std::copy(paths.begin(), paths.begin() + values, out);
+        }
+        std::fill(buffer.begin() + values * sizeof(Real), buffer.end(), 0);
+        ok = writeAll(fd, buffer.data(), buffer.size());
+    }
+    if (ok && compress){
+        std::size_t length = index.size() * sizeof(std::uint64_t);
+        ok = pwrite(fd, index.data(), length, align) == static_cast<ssize_t>(length);
+    }
+
+    if (::close(fd) != 0 || !ok){
+        std::cerr << "Failed to properly write the file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Map a path file
+bool PathStore::open(const std::string& filename){
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0){
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < PathStoreHeader::Alignment){
+        std::cerr << "Not a path file: " << filename << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED){
+        std::cerr << "Failed to map file: " << filename << std::endl;
+        return false;
+    }
+
+    const PathStoreHeader* header = static_cast<const PathStoreHeader*>(mapped);
+    std::size_t blocks = header->BlockPaths == 0 ? 0 : (header->NumPaths + header->BlockPaths - 1) / header->BlockPaths;
+    bool valid = std::memcmp(header->Magic, PathMagic, sizeof(PathMagic)) == 0
+        && (header->Version == 1 || header->Version == PathVersion)
+        && (header->ScalarBytes == 4 || header->ScalarBytes == 8) && header->BlockPaths > 0;
+    bool compressed = valid && header->Version >= 2 && header->Tolerance > 0.0;
+    if (valid && compressed){
+        // Every indexed block must lie inside the file
+        const std::uint64_t* index = reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(mapped) + header->IndexOffset);
+        valid = header->IndexOffset + 2 * blocks * sizeof(std::uint64_t) <= length;
+        for (std::size_t b = 0; valid && b < blocks; ++b){
+            valid = index[2 * b] + index[2 * b + 1] <= length;
+        }
+    } else if (valid){
+        valid = length >= PathStoreHeader::Alignment + blocks * header->BlockBytes;
+    }
+    if (!valid){
+        std::cerr << "Invalid or truncated path file: " << filename << std::endl;
+        munmap(mapped, length);
+        return false;
+    }
+
+    Mapping = mapped;
+    Length = length;
+    Header = header;
+    return true;
+}
+
+// Release the mapping
+void PathStore::close(){
+    if (Mapping != nullptr){
+        munmap(Mapping, Length);
+    }
+    Mapping = nullptr;
+    Length = 0;
+    Header = nullptr;
+}
+
+// View of a compressed block
+CompressedPathBlock PathStore::compressedBlock(std::size_t b) const{
+    if (Header == nullptr || !compressed() || b >= numBlocks()){
+        return CompressedPathBlock();
+    }
+    const char* base = static_cast<const char*>(Mapping);
+    const std::uint64_t* index = reinterpret_cast<const std::uint64_t*>(base + Header->IndexOffset);
+    return CompressedPathBlock::view(reinterpret_cast<const unsigned char*>(base + index[2 * b]), index[2 * b + 1]);
+}
+
+// Number of paths in a block
+std::size_t PathStore::blockSize(std::size_t b) const{
+    std::size_t first = b * Header->BlockPaths;
+    return std::min<std::size_t>(Header->BlockPaths, Header->NumPaths - first);
+}
+
+// Double and single precision versions
+template bool PathStore::write<double>(const std::string&, const InterestRateModel&, const std::string&, double, double,
+                                       unsigned int, unsigned int, unsigned int, unsigned int, PathLayout, double);
+template bool PathStore::write<float>(const std::string&, const InterestRateModel&, const std::string&, double, double,
+                                      unsigned int, unsigned int, unsigned int, unsigned int, PathLayout, double);
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "InterestRateModel.hpp"
+#include "CompressedPathBlock.hpp"
+
+// Arrangement of the rates inside each block of a path file
+enum class PathLayout : std::uint32_t{
+    PathMajor = 0,      // block[p * steps + i], one path after another
+    StepMajor = 1       // block[i * blockPaths + p], one time step across the block's paths
+};
+
+// On-disk header of a path file, padded to PathStoreHeader::Alignment bytes. Fields are
+// fixed width and stored in the machine's byte order
+struct PathStoreHeader{
+    static constexpr std::size_t Alignment = 4096;
+
+    char Magic[8];
+    std::uint32_t Version;
+    PathLayout Layout;
+    std::uint32_t ScalarBytes;      // 4 (float) or 8 (double)
+    std::uint32_t Steps;
+    std::uint64_t NumPaths;
+    std::uint64_t BlockPaths;       // paths per block; the last block may hold fewer
+    std::uint64_t BlockBytes;       // stride between blocks, a multiple of Alignment (0 if compressed)
+    std::uint64_t Seed;
+    double TimeStep;
+    double InitialRate;
+    double MeanReversion;
+    double LongTermMean;
+    double Volatility;
+    char Model[32];
+    double Tolerance;               // > 0: blocks are CompressedPathBlocks with this tolerance
+    std::uint64_t IndexOffset;      // compressed files: (offset, size) of every block
+};
+
+// Class for binary files of simulated short-rate paths. write() simulates the paths in
+// blocks and appends each block with one bulk write at an aligned offset; open() maps
+// a file read-only so blocks are used in place without copying or parsing. Files can
+// instead hold path-major CompressedPathBlocks, located through an index of offsets
+class PathStore{
+    private:
+        void* Mapping;
+        std::size_t Length;
+        const PathStoreHeader* Header;
+
+    public:
+        // Constructor for PathStore class
+        PathStore() : Mapping(nullptr), Length(0), Header(nullptr) {}
+        ~PathStore();
+        PathStore(const PathStore&) = delete;
+        PathStore& operator=(const PathStore&) = delete;
+
+        // Simulate numPaths paths in precision Real (float or double) and write them to
+        // filename. Normals are drawn from one stream, so the paths equal those from
+        // RateSimulator::generateNormals(numPaths, steps, seed). A positive tolerance
+        // stores compressed path-major blocks accurate to that tolerance
+        template<typename Real>
+        static bool write(const std::string& filename, const InterestRateModel& model, const std::string& modelName,
+                          double InitialRate, double timeStep, unsigned int steps, unsigned int numPaths,
+                          unsigned int seed, unsigned int blockPaths = 1024, PathLayout layout = PathLayout::PathMajor,
+                          double tolerance = 0.0);
+
+        // Map a path file, replacing any previous one
+        bool open(const std::string& filename);
+        void close();
+
+        const PathStoreHeader& header() const { return *Header; }
+        std::size_t numPaths() const { return Header->NumPaths; }
+        unsigned int steps() const { return Header->Steps; }
+        std::size_t numBlocks() const { return (Header->NumPaths + Header->BlockPaths - 1) / Header->BlockPaths; }
+
+        // Number of paths in block b
+        std::size_t blockSize(std::size_t b) const;
+
+        bool compressed() const { return Header->Tolerance > 0.0; }
+
+        // Rates of block b in the file's layout, or nullptr if Real does not match the file
+        // or the file is compressed
+        template<typename Real>
+        const Real* block(std::size_t b) const;
+
+        // View of compressed block b (empty if the file is not compressed)
+        CompressedPathBlock compressedBlock(std::size_t b) const;
+
+        // Rate of a path at a step, whatever the layout; compressed files decode the path
+        template<typename Real>
+        Real rate(std::size_t path, unsigned int step) const;
+};
+
+// Rates of a block
+template<typename Real>
+const Real* PathStore::block(std::size_t b) const{
+    if (Header == nullptr || Header->ScalarBytes != sizeof(Real) || compressed() || b >= numBlocks()){
+        return nullptr;
+    }
+    const char* base = static_cast<const char*>(Mapping) + PathStoreHeader::Alignment + b * Header->BlockBytes;
+    return reinterpret_cast<const Real*>(base);
+}
+
+// Rate of a path at a step
+template<typename Real>
+Real PathStore::rate(std::size_t path, unsigned int step) const{
+    std::size_t b = path / Header->BlockPaths;
+    std::size_t p = path % Header->BlockPaths;
+    if (compressed()){
+        std::vector<Real> rates(Header->Steps);
+        compressedBlock(b).decode(p, rates.data());
+        return rates[step];
+    }
+    const Real* rates = block<Real>(b);
+    if (Header->Layout == PathLayout::StepMajor){
+        return rates[static_cast<std::size_t>(step) * blockSize(b) + p];
+    }
+    return rates[p * Header->Steps + step];
+}
@@ -0,0 +1,90 @@
+#include "PathwiseGreeks.hpp"
+#include "Dual.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+// Tangent directions carried through the simulation
+enum Direction { dInitialRate, dMeanReversion, dLongTermMean, dVolatility, dBlackVolatility, NumDirections };
+using GreekDual = Dual<NumDirections>;
+
+// Simulate paths with dual-valued parameters and average the dual payoff over them
+template<class Model, class Payoff>
+PathwiseSensitivities averageOverPaths(const Model& model, double InitialRate, double timeStep,
+                                        unsigned int steps, unsigned int numPaths, unsigned int seed,
+                                        Payoff payoff){
+    GreekDual r0(InitialRate, dInitialRate);
+    GreekDual meanRev(model.getMeanReversion(), dMeanReversion);
+    GreekDual ltm(model.getLongTermMean(), dLongTermMean);
+    GreekDual vol(model.getVolatility(), dVolatility);
+
+    std::default_random_engine generator(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<GreekDual> rates(steps);
+    GreekDual sum = 0.0;
+
+    for (unsigned int p = 0; p < numPaths; ++p){
+        GreekDual currentRate = r0;
+        for (unsigned int i = 0; i < steps; ++i){
+            currentRate = Model::step(currentRate, meanRev, ltm, vol, timeStep, distribution(generator));
+            rates[i] = currentRate;
+        }
+        sum += payoff(rates);
+    }
+    sum /= numPaths;
+
+    PathwiseSensitivities result;
+    result.Price = sum.Value;
+    result.InitialRate = sum.d(dInitialRate);
+    result.MeanReversion = sum.d(dMeanReversion);
+    result.LongTermMean = sum.d(dLongTermMean);
+    result.Volatility = sum.d(dVolatility);
+    result.BlackVolatility = sum.d(dBlackVolatility);
+    return result;
+}
+
+template<class Model>
+PathwiseSensitivities bondGreeks(const Bond& bond, const Model& model, double InitialRate,
+                                double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed){
+    return averageOverPaths(model, InitialRate, timeStep, steps, numPaths, seed,
+        [&](const std::vector<GreekDual>& rates){ return bond.price(rates, timeStep); });
+}
+
+template<class Model>
+PathwiseSensitivities swaptionGreeks(const Swaption& swaption, const Model& model, double InitialRate,
+                                    double volatility, double f, bool isPayer,
+                                    double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed){
+    GreekDual blackVol(volatility, dBlackVolatility);
+    return averageOverPaths(model, InitialRate, timeStep, steps, numPaths, seed,
+        [&](const std::vector<GreekDual>& rates){ return swaption.price(rates, blackVol, timeStep, f, isPayer); });
+}
+
+}
+
+// Bond sensitivities under the Vasicek model
+PathwiseSensitivities PathwiseGreeks::bondSensitivities(const Bond& bond, const VasicekModel& model, double InitialRate,
+                                        double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const{
+    return bondGreeks(bond, model, InitialRate, timeStep, steps, numPaths, seed);
+}
+
+// Bond sensitivities under the CIR model
+PathwiseSensitivities PathwiseGreeks::bondSensitivities(const Bond& bond, const CIRModel& model, double InitialRate,
+                                        double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const{
+    return bondGreeks(bond, model, InitialRate, timeStep, steps, numPaths, seed);
+}
+
+// Swaption sensitivities under the Vasicek model
+PathwiseSensitivities PathwiseGreeks::swaptionSensitivities(const Swaption& swaption, const VasicekModel& model, double InitialRate,
+                                        double volatility, double f, bool isPayer,
+                                        double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const{
+    return swaptionGreeks(swaption, model, InitialRate, volatility, f, isPayer, timeStep, steps, numPaths, seed);
+}
+
+// Swaption sensitivities under the CIR model
+PathwiseSensitivities PathwiseGreeks::swaptionSensitivities(const Swaption& swaption, const CIRModel& model, double InitialRate,
+                                        double volatility, double f, bool isPayer,
+                                        double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const{
+    return swaptionGreeks(swaption, model, InitialRate, volatility, f, isPayer, timeStep, steps, numPaths, seed);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Bond.hpp"
+#include "Swaption.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+
+// Monte Carlo price and its pathwise sensitivities
+struct PathwiseSensitivities{
+    double Price = 0.0;
+    double InitialRate = 0.0;
+    double MeanReversion = 0.0;
+    double LongTermMean = 0.0;
+    double Volatility = 0.0;
+    double BlackVolatility = 0.0;
+};
+
+// Class for computing exact pathwise Greeks in one pass with forward-mode dual numbers.
+// All tangent directions share the same normals, so results are noise-consistent with
+// the price itself (common random numbers) instead of relying on finite-difference bumps.
+class PathwiseGreeks{
+    public:
+
+        // Bond price and sensitivities to the initial rate and model parameters
+        PathwiseSensitivities bondSensitivities(const Bond& bond, const VasicekModel& model, double InitialRate,
+                                            double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const;
+        PathwiseSensitivities bondSensitivities(const Bond& bond, const CIRModel& model, double InitialRate,
+                                            double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const;
+
+        // Swaption price and sensitivities, including Black volatility
+        PathwiseSensitivities swaptionSensitivities(const Swaption& swaption, const VasicekModel& model, double InitialRate,
+                                            double volatility, double f, bool isPayer,
+                                            double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const;
+        PathwiseSensitivities swaptionSensitivities(const Swaption& swaption, const CIRModel& model, double InitialRate,
+                                            double volatility, double f, bool isPayer,
+                                            double timeStep, unsigned int steps, unsigned int numPaths, unsigned int seed) const;
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <utility>
+
+// Scalar type used to accumulate prices from paths stored as T. Mixing with a double
+// promotes float paths to double sums, and leaves double and Dual unchanged
+template<typename T>
+using Accumulator = decltype(std::declval<T>() * 1.0);
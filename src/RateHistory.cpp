@@ -0,0 +1,120 @@
+#include "RateHistory.hpp"
+#include <charconv>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Load a history file through a read-only memory mapping
+bool RateHistory::load(const std::string& filename){
+    Names.clear();
+    Series.clear();
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0){
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0){
+        std::cerr << "Empty or unreadable file: " << filename << std::endl;
+        close(fd);
+        return false;
+    }
+
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED){
+        std::cerr << "Failed to map file: " << filename << std::endl;
+        return false;
+    }
+
+    // The file is read front to back exactly once
+    madvise(mapped, length, MADV_SEQUENTIAL);
+
+    const char* begin = static_cast<const char*>(mapped);
+    bool ok = parse(begin, begin + length);
+    munmap(mapped, length);
+    return ok;
+}
+
+// Parse the CSV text in [begin, end)
+bool RateHistory::parse(const char* begin, const char* end){
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+    const char* p = begin;
+
+    // Header: skip the label column, then one name per series
+    const char* lineEnd = p;
+    while (lineEnd < end && *lineEnd != '\n') ++lineEnd;
+    const char* cell = p;
+    bool first = true;
+    for (const char* c = p; c <= lineEnd; ++c){
+        if (c == lineEnd || *c == ','){
+            const char* cellEnd = c;
+            if (cellEnd > cell && cellEnd[-1] == '\r') --cellEnd;
+            if (!first){
+                Names.emplace_back(cell, cellEnd);
+            }
+            first = false;
+            cell = c + 1;
+        }
+    }
+    if (Names.empty()){
+        std::cerr << "No series in rate history header." << std::endl;
+        return false;
+    }
+    Series.assign(Names.size(), std::vector<double>());
+
+    // Reserve from a rough row count so the columns grow without reallocating
+    std::size_t rows = 0;
+    for (const char* c = lineEnd; c < end; ++c) rows += (*c == '\n');
+    for (std::vector<double>& s : Series) s.reserve(rows);
+
+    p = lineEnd < end ? lineEnd + 1 : end;
+    while (p < end){
+        // Skip the label column
+        while (p < end && *p != ',' && *p != '\n') ++p;
+        if (p >= end || *p == '\n'){
+            ++p;
+            continue;
+        }
+        ++p;
+
+        for (std::size_t col = 0; col < Series.size(); ++col){
+            while (p < end && *p == ' ') ++p;
+            double value = missing;
+            const char* next = p;
+            auto parsed = std::from_chars(p, end, value);
+            if (parsed.ec == std::errc()){
+                next = parsed.ptr;
+            } else {
+                value = missing;
+            }
+
+            // Move past the rest of the cell
+            while (next < end && *next != ',' && *next != '\n') ++next;
+            Series[col].push_back(value);
+
+            if (next < end && *next == ','){
+                p = next + 1;
+            } else {
+                // Short row: remaining columns are gaps
+                for (std::size_t rest = col + 1; rest < Series.size(); ++rest){
+                    Series[rest].push_back(missing);
+                }
+                p = next;
+                break;
+            }
+        }
+
+        // Ignore extra columns and move to the next line
+        while (p < end && *p != '\n') ++p;
+        ++p;
+    }
+    return true;
+}
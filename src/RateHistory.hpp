@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Class holding historical short-rate series loaded from a CSV file.
+// The file is memory-mapped and parsed in place with std::from_chars; the first row is a
+// header "date,NAME1,NAME2,...", the first column is a label that is skipped, and empty or
+// non-numeric cells are stored as NaN (gaps)
+class RateHistory{
+    private:
+        std::vector<std::string> Names;
+        std::vector<std::vector<double>> Series;
+
+        bool parse(const char* begin, const char* end);
+
+    public:
+        // Load a history file, replacing any previous contents
+        bool load(const std::string& filename);
+
+        // Number of series (columns after the label column)
+        std::size_t size() const { return Series.size(); }
+
+        const std::string& name(std::size_t i) const { return Names[i]; }
+        const std::vector<double>& series(std::size_t i) const { return Series[i]; }
+};
@@ -1,21 +1,46 @@
 #include "RateSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "Instrumentation.hpp"
+#include "TraceRecorder.hpp"
+#include <random>
+#include <type_traits>
 
 // Simulate interest rate paths
 std::vector<double> RateSimulator::simulatePaths(InterestRateModel& model, double InitialRate,
                                             double timeStep, unsigned int steps) const{
 
+    IR_COUNT(Allocations, 1);
+
     // Initialize a vector to store simulated rates
     std::vector<double> rates(steps);
+    simulatePath(model, InitialRate, timeStep, steps, rates.data());
+    return rates; 
+}
+
+// Simulate one path from the model's generator
+void RateSimulator::simulatePath(InterestRateModel& model, double InitialRate, double timeStep,
+                                            unsigned int steps, double* out) const{
+    IR_PROFILE_SCOPE(Stepping);
+    IR_COUNT(Paths, 1);
 
     // Set initial rate
     double currentRate = InitialRate;
+    model.startPath();
 
     // Simulate rates for number of steps
-    for (int i = 0; i < steps; ++i){
+    for (unsigned int i = 0; i < steps; ++i){
         currentRate = model.simulateNextRate(currentRate, timeStep);
-        rates[i] = currentRate;
+        out[i] = currentRate;
     }
-    return rates; 
+}
+
+// Simulate a path into the workspace
+const std::vector<double>& RateSimulator::simulatePaths(InterestRateModel& model, double InitialRate, double timeStep,
+                                            unsigned int steps, SimulationWorkspace& workspace) const{
+    std::vector<double>& rates = workspace.rates(steps);
+    simulatePath(model, InitialRate, timeStep, steps, rates.data());
+    return rates;
 }
 
 // Price a bond using simulated interest rate paths
@@ -27,4 +52,207 @@ double RateSimulator::priceBond(const Bond& bond, InterestRateModel& model, doub
 
     // Calculate bond price using simulated rate path
     return bond.price(rates, timeStep);
-}
\ No newline at end of file
+}
+
+// Price a bond on a path simulated into the workspace
+double RateSimulator::priceBond(const Bond& bond, InterestRateModel& model, double InitialRate,
+                                            double timeStep, unsigned int steps, SimulationWorkspace& workspace) const{
+    return bond.price(simulatePaths(model, InitialRate, timeStep, steps, workspace), timeStep);
+}
+
+// Price a swaption on a path simulated into the workspace
+double RateSimulator::priceSwaption(const Swaption& swaption, InterestRateModel& model, double InitialRate,
+                                            double timeStep, unsigned int steps, double volatility, double f,
+                                            bool isPayer, SimulationWorkspace& workspace) const{
+    return swaption.price(simulatePaths(model, InitialRate, timeStep, steps, workspace), volatility, timeStep, f, isPayer);
+}
+
+// Simulate a path on a time grid, stepping node to node
+std::vector<double> RateSimulator::simulatePaths(InterestRateModel& model, double InitialRate, const TimeGrid& grid) const{
+    IR_PROFILE_SCOPE(Stepping);
+    IR_COUNT(Allocations, 1);
+    IR_COUNT(Paths, 1);
+
+    std::vector<double> rates(grid.size());
+    double currentRate = InitialRate;
+    model.startPath();
+
+    for (std::size_t i = 0; i < grid.size(); ++i){
+        currentRate = model.simulateNextRate(currentRate, grid.step(i));
+        rates[i] = currentRate;
+    }
+    return rates;
+}
+
+// Price a bond off a path on a time grid
+double RateSimulator::priceBond(const Bond& bond, InterestRateModel& model, double InitialRate, const TimeGrid& grid) const{
+    std::vector<double> rates = simulatePaths(model, InitialRate, grid);
+    return Bond::price(rates.data(), bond.cashFlowSchedule(grid));
+}
+
+// Generate a block of standard normals
+template<typename Real>
+std::vector<Real> RateSimulator::generateNormals(unsigned int paths, unsigned int steps, unsigned int seed) const{
+    IR_COUNT(Allocations, 1);
+    std::vector<Real> normals(static_cast<std::size_t>(paths) * steps);
+    generateNormals(paths, steps, seed, normals.data());
+    return normals;
+}
+
+template<typename Real>
+void RateSimulator::generateNormals(unsigned int paths, unsigned int steps, unsigned int seed, Real* out) const{
+    IR_PROFILE_SCOPE(Rng);
+    TraceScope trace("normals", "rng", static_cast<std::int64_t>(paths) * steps);
+    std::default_random_engine generator(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+
+    std::size_t count = static_cast<std::size_t>(paths) * steps;
+    for (std::size_t i = 0; i < count; ++i){
+        out[i] = static_cast<Real>(distribution(generator));
+    }
+}
+
+namespace {
+    // Paths of a model whose step is a static template, run in precision Real
+    template<typename Model, typename Real>
+    void stepBlock(const Model& model, double InitialRate, double timeStep, unsigned int steps,
+                   const Real* normals, unsigned int paths, Real* out){
+        const Real meanRev = static_cast<Real>(model.getMeanReversion());
+        const Real ltm = static_cast<Real>(model.getLongTermMean());
+        const Real vol = static_cast<Real>(model.getVolatility());
+        const Real dt = static_cast<Real>(timeStep);
+
+        for (unsigned int p = 0; p < paths; ++p){
+            const Real* dw = normals + static_cast<std::size_t>(p) * steps;
+            Real* rates = out + static_cast<std::size_t>(p) * steps;
+
+            Real currentRate = static_cast<Real>(InitialRate);
+            for (unsigned int i = 0; i < steps; ++i){
+                currentRate = Model::template step<Real, Real>(currentRate, meanRev, ltm, vol, dt, dw[i]);
+                rates[i] = currentRate;
+                if constexpr (std::is_same<Model, CIRModel>::value){
+                    IR_COUNT(RejectedSamples, currentRate == Real(0));
+                }
+            }
+        }
+    }
+}
+
+// Simulate a block of paths driven by given normals
+template<typename Real>
+void RateSimulator::simulatePathBlock(const InterestRateModel& model, double InitialRate, double timeStep,
+                                unsigned int steps, const Real* normals, unsigned int paths, Real* out) const{
+    IR_PROFILE_SCOPE(Stepping);
+    IR_COUNT(Paths, paths);
+    IR_COUNT(Steps, static_cast<std::uint64_t>(paths) * steps);
+
+    if (const VasicekModel* vasicek = dynamic_cast<const VasicekModel*>(&model)){
+        stepBlock(*vasicek, InitialRate, timeStep, steps, normals, paths, out);
+        return;
+    }
+    if (const CIRModel* cir = dynamic_cast<const CIRModel*>(&model)){
+        stepBlock(*cir, InitialRate, timeStep, steps, normals, paths, out);
+        return;
+    }
+
+    for (unsigned int p = 0; p < paths; ++p){
+        const Real* dw = normals + static_cast<std::size_t>(p) * steps;
+        Real* rates = out + static_cast<std::size_t>(p) * steps;
+
+        double currentRate = InitialRate;
+        for (unsigned int i = 0; i < steps; ++i){
+            currentRate = model.nextRate(currentRate, i * timeStep, timeStep, dw[i]);
+            rates[i] = static_cast<Real>(currentRate);
+        }
+    }
+}
+
+template<typename Real>
+std::vector<Real> RateSimulator::simulatePathBlock(const InterestRateModel& model, double InitialRate, double timeStep,
+                                unsigned int steps, const std::vector<Real>& normals) const{
+    unsigned int paths = steps == 0 ? 0 : static_cast<unsigned int>(normals.size() / steps);
+    IR_COUNT(Allocations, 1);
+    std::vector<Real> out(normals.size());
+    simulatePathBlock(model, InitialRate, timeStep, steps, normals.data(), paths, out.data());
+    return out;
+}
+
+// Simulate a block of paths on a time grid from given normals
+void RateSimulator::simulatePathBlock(const InterestRateModel& model, double InitialRate, const TimeGrid& grid,
+                                const double* normals, unsigned int paths, double* out) const{
+    IR_PROFILE_SCOPE(Stepping);
+    IR_COUNT(Paths, paths);
+    IR_COUNT(Steps, static_cast<std::uint64_t>(paths) * grid.size());
+
+    std::size_t steps = grid.size();
+    for (unsigned int p = 0; p < paths; ++p){
+        const double* dw = normals + p * steps;
+        double* rates = out + p * steps;
+
+        double currentRate = InitialRate;
+        for (std::size_t i = 0; i < steps; ++i){
+            currentRate = model.nextRate(currentRate, grid.time(i) - grid.step(i), grid.step(i), dw[i]);
+            rates[i] = currentRate;
+        }
+    }
+}
+
+// Step every node of the grid, recording only the observed slices
+void RateSimulator::simulateObserved(const InterestRateModel& model, double InitialRate, const TimeGrid& grid,
+                                const ObservationSchedule& schedule, const double* normals, unsigned int paths,
+                                double* rates, double* integrals) const{
+    IR_PROFILE_SCOPE(Stepping);
+    IR_COUNT(Paths, paths);
+    IR_COUNT(Steps, static_cast<std::uint64_t>(paths) * grid.size());
+
+    std::size_t steps = grid.size();
+    std::size_t observations = schedule.size();
+    bool recordIntegrals = schedule.integrals();
+    for (unsigned int p = 0; p < paths; ++p){
+        const double* dw = normals + p * steps;
+        double* observed = rates + p * observations;
+
+        double currentRate = InitialRate;
+        double integral = 0.0;
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < steps && k < observations; ++i){
+            double nextRate = model.nextRate(currentRate, grid.time(i) - grid.step(i), grid.step(i), dw[i]);
+
+            // Trapezoidal integral of the short rate from time 0
+            integral += 0.5 * (currentRate + nextRate) * grid.step(i);
+            currentRate = nextRate;
+
+            if (i == schedule.node(k)){
+                observed[k] = currentRate;
+                if (recordIntegrals) integrals[p * observations + k] = integral;
+                ++k;
+            }
+        }
+    }
+}
+
+ObservedPaths RateSimulator::simulateObserved(const InterestRateModel& model, double InitialRate, const TimeGrid& grid,
+                                const ObservationSchedule& schedule, const std::vector<double>& normals) const{
+    unsigned int paths = grid.size() == 0 ? 0 : static_cast<unsigned int>(normals.size() / grid.size());
+    IR_COUNT(Allocations, 1);
+    ObservedPaths out;
+    out.Rates.resize(static_cast<std::size_t>(paths) * schedule.size());
+    if (schedule.integrals()) out.Integrals.resize(out.Rates.size());
+    simulateObserved(model, InitialRate, grid, schedule, normals.data(), paths, out.Rates.data(),
+                     schedule.integrals() ? out.Integrals.data() : nullptr);
+    return out;
+}
+
+// Double and single precision versions
+template std::vector<double> RateSimulator::generateNormals<double>(unsigned int, unsigned int, unsigned int) const;
+template std::vector<float> RateSimulator::generateNormals<float>(unsigned int, unsigned int, unsigned int) const;
+template void RateSimulator::generateNormals<double>(unsigned int, unsigned int, unsigned int, double*) const;
+template void RateSimulator::generateNormals<float>(unsigned int, unsigned int, unsigned int, float*) const;
+template void RateSimulator::simulatePathBlock<double>(const InterestRateModel&, double, double, unsigned int,
+                                const double*, unsigned int, double*) const;
+template void RateSimulator::simulatePathBlock<float>(const InterestRateModel&, double, double, unsigned int,
+                                const float*, unsigned int, float*) const;
+template std::vector<double> RateSimulator::simulatePathBlock<double>(const InterestRateModel&, double, double, unsigned int,
+                                const std::vector<double>&) const;
+template std::vector<float> RateSimulator::simulatePathBlock<float>(const InterestRateModel&, double, double, unsigned int,
+                                const std::vector<float>&) const;
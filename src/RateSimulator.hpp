@@ -3,6 +3,10 @@
 #include <vector>
 #include "InterestRateModel.hpp"
 #include "Bond.hpp"
+#include "Swaption.hpp"
+#include "SimulationWorkspace.hpp"
+#include "TimeGrid.hpp"
+#include "ObservationSchedule.hpp"
 
 // Class for simulating paths and pricing bonds
 class RateSimulator{
@@ -15,5 +19,63 @@ class RateSimulator{
         // Price a bond using paths
         double priceBond(const Bond& bond, InterestRateModel& model, double InitialRate,
                                             double timeStep, unsigned int steps) const;
-};
 
+        // Allocation-free versions: the path is simulated into the workspace, and the
+        // returned reference stays valid until the workspace is next used
+        const std::vector<double>& simulatePaths(InterestRateModel& model, double InitialRate, double timeStep,
+                                            unsigned int steps, SimulationWorkspace& workspace) const;
+
+        double priceBond(const Bond& bond, InterestRateModel& model, double InitialRate,
+                                            double timeStep, unsigned int steps, SimulationWorkspace& workspace) const;
+
+        double priceSwaption(const Swaption& swaption, InterestRateModel& model, double InitialRate,
+                                            double timeStep, unsigned int steps, double volatility, double f,
+                                            bool isPayer, SimulationWorkspace& workspace) const;
+
+        // Simulate a path on a (possibly non-uniform) time grid, one rate per node
+        std::vector<double> simulatePaths(InterestRateModel& model, double InitialRate, const TimeGrid& grid) const;
+
+        // Price a bond off a path on the grid, reading each cash flow at its own node
+        double priceBond(const Bond& bond, InterestRateModel& model, double InitialRate, const TimeGrid& grid) const;
+
+        // Simulate a block of paths on a time grid from given normals (grid.size() per path,
+        // path-major), stepping with the model's nextRate
+        void simulatePathBlock(const InterestRateModel& model, double InitialRate, const TimeGrid& grid,
+                                const double* normals, unsigned int paths, double* out) const;
+
+        // Simulate a block of paths on the grid from given normals (grid.size() per path,
+        // path-major) but keep only the schedule's slices: paths x schedule.size() rates, and
+        // as many running integrals when the schedule records them (integrals may be null otherwise)
+        void simulateObserved(const InterestRateModel& model, double InitialRate, const TimeGrid& grid,
+                                const ObservationSchedule& schedule, const double* normals, unsigned int paths,
+                                double* rates, double* integrals) const;
+
+        ObservedPaths simulateObserved(const InterestRateModel& model, double InitialRate, const TimeGrid& grid,
+                                const ObservationSchedule& schedule, const std::vector<double>& normals) const;
+
+        // Generate standard normals for a block of paths (paths x steps, path-major).
+        // The same seed always gives the same block, for common random numbers; float
+        // blocks hold the same draws rounded, so float and double runs are comparable
+        template<typename Real = double>
+        std::vector<Real> generateNormals(unsigned int paths, unsigned int steps, unsigned int seed) const;
+
+        // The same draws written to out[0, paths * steps)
+        template<typename Real>
+        void generateNormals(unsigned int paths, unsigned int steps, unsigned int seed, Real* out) const;
+
+        // Simulate a block of paths driven by given normals. Both normals and out are
+        // path-major with `steps` entries per path. Real is double or float; Vasicek and
+        // CIR paths are stepped entirely in Real, other models step in double and store Real
+        template<typename Real>
+        void simulatePathBlock(const InterestRateModel& model, double InitialRate, double timeStep,
+                                unsigned int steps, const Real* normals, unsigned int paths, Real* out) const;
+
+        template<typename Real>
+        std::vector<Real> simulatePathBlock(const InterestRateModel& model, double InitialRate, double timeStep,
+                                unsigned int steps, const std::vector<Real>& normals) const;
+
+    private:
+        // Fill out[0, steps) with one path from the model's own generator
+        void simulatePath(InterestRateModel& model, double InitialRate, double timeStep,
+                                unsigned int steps, double* out) const;
+};
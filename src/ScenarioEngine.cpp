@@ -0,0 +1,110 @@
+#include "ScenarioEngine.hpp"
+#include "ParallelFor.hpp"
+#include "RateSimulator.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <memory>
+
+// Constructor for ScenarioEngine class
+ScenarioEngine::ScenarioEngine(unsigned int numPaths, double timeStep, unsigned int steps, unsigned int seed,
+                                unsigned int threads, unsigned int blockSize)
+    : NumPaths(numPaths), TimeStep(timeStep), Steps(steps), Threads(resolveThreadCount(threads)),
+      BlockSize(std::max(1u, blockSize)) {
+    RateSimulator simulator;
+    Normals = simulator.generateNormals(NumPaths, Steps, seed);
+    setHugePages(false);
+}
+
+// Map one arena per worker, sized for a path block
+void ScenarioEngine::setHugePages(bool enable){
+    std::lock_guard<std::mutex> lock(ArenaLock);
+    Arenas.clear();
+    for (unsigned int w = 0; w < Threads; ++w){
+        Arenas.emplace_back(static_cast<std::size_t>(BlockSize) * Steps * sizeof(double) + 4096, enable);
+    }
+}
+
+// Price all instruments under every scenario
+std::vector<ScenarioResult> ScenarioEngine::run(const InterestRateModel& model, double InitialRate,
+                                        const std::vector<Scenario>& scenarios,
+                                        const std::vector<Bond>& bonds,
+                                        const std::vector<SwaptionTrade>& swaptions) const{
+    RateSimulator simulator;
+    std::size_t numInstruments = bonds.size() + swaptions.size();
+    std::size_t numBlocks = (NumPaths + BlockSize - 1) / BlockSize;
+
+    // Build the bumped models up front so workers only read shared state
+    std::vector<std::unique_ptr<InterestRateModel>> models;
+    for (const Scenario& s : scenarios){
+        std::unique_ptr<InterestRateModel> bumped = model.clone();
+        bumped->setParameters(model.getMeanReversion() + s.MeanReversionShift,
+                              model.getLongTermMean() + s.LongTermMeanShift,
+                              model.getVolatility() + s.VolatilityShift);
+        models.push_back(std::move(bumped));
+    }
+
+    // Bond schedules do not depend on the scenario, so compile them once
+    std::vector<std::vector<CashFlow>> schedules;
+    for (const Bond& bond : bonds){
+        schedules.push_back(bond.cashFlowSchedule(TimeStep, Steps));
+    }
+
+    // Per-(scenario, block) partial sums; path buffers come from the worker arenas
+    std::vector<double> partial(scenarios.size() * numBlocks * numInstruments, 0.0);
+    std::lock_guard<std::mutex> lock(ArenaLock);
+
+    parallelFor(scenarios.size() * numBlocks, Threads, [&](std::size_t item, unsigned int worker){
+        std::size_t s = item / numBlocks;
+        std::size_t b = item % numBlocks;
+        unsigned int first = static_cast<unsigned int>(b * BlockSize);
+        unsigned int paths = std::min(BlockSize, NumPaths - first);
+
+        ArenaScope scope(Arenas[worker]);
+        double* rates = Arenas[worker].allocate<double>(static_cast<std::size_t>(paths) * Steps);
+        {
+            TraceScope trace("simulate block", "generate", paths);
+            simulator.simulatePathBlock(*models[s], InitialRate + scenarios[s].InitialRateShift, TimeStep, Steps,
+                                        Normals.data() + static_cast<std::size_t>(first) * Steps, paths, rates);
+        }
+
+        TraceScope trace("price block", "pricing", paths);
+        double* sums = partial.data() + item * numInstruments;
+        for (unsigned int p = 0; p < paths; ++p){
+            const double* path = rates + static_cast<std::size_t>(p) * Steps;
+            for (std::size_t k = 0; k < bonds.size(); ++k){
+                sums[k] += Bond::price(path, schedules[k]);
+            }
+            for (std::size_t k = 0; k < swaptions.size(); ++k){
+                const SwaptionTrade& trade = swaptions[k];
+                double vol = trade.Volatility + scenarios[s].SwaptionVolShift;
+                sums[bonds.size() + k] += trade.Instrument.price(path, Steps, vol, TimeStep, trade.Frequency, trade.IsPayer);
+            }
+        }
+    });
+
+    // Reduce blocks in a fixed order so results do not depend on the thread count
+    TraceScope trace("reduce", "reduction", static_cast<std::int64_t>(partial.size()));
+    std::vector<ScenarioResult> results;
+    for (std::size_t s = 0; s < scenarios.size(); ++s){
+        std::vector<double> totals(numInstruments, 0.0);
+        for (std::size_t b = 0; b < numBlocks; ++b){
+            const double* sums = partial.data() + (s * numBlocks + b) * numInstruments;
+            for (std::size_t k = 0; k < numInstruments; ++k){
+                totals[k] += sums[k];
+            }
+        }
+
+        ScenarioResult result;
+        result.Name = scenarios[s].Name;
+        for (std::size_t k = 0; k < numInstruments; ++k){
+            double price = NumPaths == 0 ? 0.0 : totals[k] / NumPaths;
+            if (k < bonds.size()){
+                result.BondPrices.push_back(price);
+            } else {
+                result.SwaptionPrices.push_back(price);
+            }
+        }
+        results.push_back(result);
+    }
+    return results;
+}
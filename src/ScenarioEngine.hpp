@@ -0,0 +1,66 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "InterestRateModel.hpp"
+#include "ScratchArena.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+
+// Parameter and market input shifts applied on top of the base case
+struct Scenario{
+    std::string Name;
+    double MeanReversionShift = 0.0;
+    double LongTermMeanShift = 0.0;
+    double VolatilityShift = 0.0;
+    double InitialRateShift = 0.0;
+    double SwaptionVolShift = 0.0;
+};
+
+// Swaption together with its Black pricing inputs
+struct SwaptionTrade{
+    Swaption Instrument;
+    double Volatility;
+    double Frequency;
+    bool IsPayer;
+};
+
+// Monte Carlo prices of every instrument under one scenario
+struct ScenarioResult{
+    std::string Name;
+    std::vector<double> BondPrices;
+    std::vector<double> SwaptionPrices;
+};
+
+// Class for bump-and-revalue stress runs. The normals are drawn once and shared by every
+// scenario (common random numbers), bond schedules are compiled once, and (scenario, path
+// block) pairs are evaluated in parallel. Each worker's path block comes from its own
+// scratch arena, kept across runs so repeated runs reuse already faulted-in memory
+class ScenarioEngine{
+    private:
+        unsigned int NumPaths;
+        double TimeStep;
+        unsigned int Steps;
+        unsigned int Threads;
+        unsigned int BlockSize;
+        std::vector<double> Normals;
+
+        // Per-worker scratch; runs on one engine take turns using it
+        mutable std::vector<ScratchArena> Arenas;
+        mutable std::mutex ArenaLock;
+
+    public:
+        // Constructor for ScenarioEngine class; threads = 0 uses all cores
+        ScenarioEngine(unsigned int numPaths, double timeStep, unsigned int steps, unsigned int seed,
+                        unsigned int threads = 0, unsigned int blockSize = 256);
+
+        // Back the worker arenas with huge pages
+        void setHugePages(bool enable);
+
+        // Price all instruments under every scenario
+        std::vector<ScenarioResult> run(const InterestRateModel& model, double InitialRate,
+                                        const std::vector<Scenario>& scenarios,
+                                        const std::vector<Bond>& bonds,
+                                        const std::vector<SwaptionTrade>& swaptions) const;
+};
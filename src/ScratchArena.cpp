@@ -0,0 +1,150 @@
+#include "ScratchArena.hpp"
+#include "Instrumentation.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+
+namespace {
+    const std::size_t PageSize = 4096;
+
+    std::size_t roundUp(std::size_t value, std::size_t multiple){
+        return (value + multiple - 1) / multiple * multiple;
+    }
+}
+
+// Constructor for ScratchArena class
+ScratchArena::ScratchArena(std::size_t capacity, bool hugePages)
+    : Current(0), Offset(0), HugePages(hugePages){
+    Chunks.push_back(map(std::max(capacity, PageSize)));
+}
+
+ScratchArena::~ScratchArena(){
+    release();
+}
+
+ScratchArena::ScratchArena(ScratchArena&& other) noexcept
+    : Chunks(std::move(other.Chunks)), Current(other.Current), Offset(other.Offset), HugePages(other.HugePages){
+    other.Chunks.clear();
+    other.Current = 0;
+    other.Offset = 0;
+}
+
+ScratchArena& ScratchArena::operator=(ScratchArena&& other) noexcept{
+    if (this != &other){
+        release();
+        Chunks = std::move(other.Chunks);
+        Current = other.Current;
+        Offset = other.Offset;
+        HugePages = other.HugePages;
+        other.Chunks.clear();
+        other.Current = 0;
+        other.Offset = 0;
+    }
+    return *this;
+}
+
+// Map a chunk of at least `bytes`
+ScratchArena::Chunk ScratchArena::map(std::size_t bytes) const{
+    IR_COUNT(Allocations, 1);
+    if (HugePages){
+        std::size_t size = roundUp(bytes, HugePageSize);
+#ifdef MAP_HUGETLB
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED){
+            return {static_cast<char*>(p), size, true};
+        }
+#endif
+        // No reserved huge pages: over-map, trim to a 2 MB boundary and ask for THP
+        void* raw = mmap(nullptr, size + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED){
+            char* start = static_cast<char*>(raw);
+            char* aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<std::uintptr_t>(start), HugePageSize));
+            std::size_t head = static_cast<std::size_t>(aligned - start);
+            if (head > 0) munmap(start, head);
+            if (HugePageSize - head > 0) munmap(aligned + size, HugePageSize - head);
+#ifdef MADV_HUGEPAGE
+            madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+            return {aligned, size, false};
+        }
+    }
+    else{
+        std::size_t size = roundUp(bytes, PageSize);
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED){
+            return {static_cast<char*>(p), size, false};
+        }
+    }
+    std::cerr << "Failed to map " << bytes << " bytes of scratch memory." << std::endl;
+    throw std::bad_alloc();
+}
+
+void ScratchArena::unmap(const Chunk& chunk){
+    munmap(chunk.Base, chunk.Size);
+}
+
+void ScratchArena::release(){
+    for (const Chunk& chunk : Chunks){
+        unmap(chunk);
+    }
+    Chunks.clear();
+}
+
+// Bump within the current chunk, moving to a later chunk (or mapping one) when full
+void* ScratchArena::allocateBytes(std::size_t bytes, std::size_t alignment){
+    for (;;){
+        const Chunk& chunk = Chunks[Current];
+        std::size_t start = roundUp(Offset, alignment);
+        if (start + bytes <= chunk.Size){
+            Offset = start + bytes;
+            return chunk.Base + start;
+        }
+        if (Current + 1 < Chunks.size() && Chunks[Current + 1].Size >= bytes + alignment){
+            ++Current;
+            Offset = 0;
+            continue;
+        }
+
+        // Drop the chunks past the current one and map one large enough to double the arena
+        for (std::size_t c = Current + 1; c < Chunks.size(); ++c){
+            unmap(Chunks[c]);
+        }
+        Chunks.resize(Current + 1);
+        Chunks.push_back(map(std::max(bytes + alignment, capacity())));
+        ++Current;
+        Offset = 0;
+    }
+}
+
+void ScratchArena::rewind(const Mark& m){
+    Current = m.Chunk;
+    Offset = m.Offset;
+}
+
+void ScratchArena::reset(){
+    if (Chunks.size() > 1){
+        std::size_t total = capacity();
+        release();
+        Chunks.push_back(map(total));
+    }
+    Current = 0;
+    Offset = 0;
+}
+
+std::size_t ScratchArena::capacity() const{
+    std::size_t total = 0;
+    for (const Chunk& chunk : Chunks) total += chunk.Size;
+    return total;
+}
+
+std::size_t ScratchArena::used() const{
+    std::size_t total = Offset;
+    for (std::size_t c = 0; c < Current; ++c) total += Chunks[c].Size;
+    return total;
+}
+
+bool ScratchArena::explicitHugePages() const{
+    return !Chunks.empty() && Chunks[0].Explicit;
+}
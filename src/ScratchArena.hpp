@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Bump allocator for short-lived batch buffers (path blocks, normals, payoff scratch).
+// Memory comes from mmap in large chunks, so acquiring a buffer is a pointer bump and big
+// path matrices never touch the malloc heap. A batch takes a mark (or an ArenaScope) and
+// rewinds to it when done; reset() also folds any overflow chunks into one, so after the
+// first run of a given size every batch is served from a single, already faulted-in region.
+// With hugePages the chunks use explicit huge pages where the system has them, otherwise
+// 2 MB aligned memory advised for transparent huge pages. An arena belongs to one thread
+class ScratchArena{
+    public:
+        static constexpr std::size_t HugePageSize = 2u << 20;
+
+        // Position to rewind to
+        struct Mark{
+            std::size_t Chunk;
+            std::size_t Offset;
+        };
+
+        // Constructor for ScratchArena class; capacity is the initial size in bytes
+        explicit ScratchArena(std::size_t capacity = 1u << 20, bool hugePages = false);
+        ~ScratchArena();
+
+        ScratchArena(ScratchArena&& other) noexcept;
+        ScratchArena& operator=(ScratchArena&& other) noexcept;
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        // Uninitialised storage for `bytes` bytes; alignment must be a power of two
+        void* allocateBytes(std::size_t bytes, std::size_t alignment = 64);
+
+        // Uninitialised, cache-line aligned storage for count values of T
+        template<typename T>
+        T* allocate(std::size_t count){
+            return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T) > 64 ? alignof(T) : 64));
+        }
+
+        Mark mark() const { return {Current, Offset}; }
+        void rewind(const Mark& m);
+
+        // Release everything and merge overflow chunks into one
+        void reset();
+
+        // Bytes mapped, and bytes consumed since the last reset (skipped chunk tails included)
+        std::size_t capacity() const;
+        std::size_t used() const;
+        std::size_t chunks() const { return Chunks.size(); }
+
+        // True if the arena asked for huge pages, and whether explicit huge pages were granted
+        bool hugePages() const { return HugePages; }
+        bool explicitHugePages() const;
+
+    private:
+        struct Chunk{
+            char* Base;
+            std::size_t Size;
+            bool Explicit;      // MAP_HUGETLB
+        };
+
+        std::vector<Chunk> Chunks;
+        std::size_t Current;
+        std::size_t Offset;
+        bool HugePages;
+
+        Chunk map(std::size_t bytes) const;
+        static void unmap(const Chunk& chunk);
+        void release();
+};
+
+// Rewinds an arena to where it was when the scope began
+class ArenaScope{
+    private:
+        ScratchArena& Arena;
+        ScratchArena::Mark Saved;
+
+    public:
+        explicit ArenaScope(ScratchArena& arena) : Arena(arena), Saved(arena.mark()) {}
+        ~ArenaScope(){ Arena.rewind(Saved); }
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Instrumentation.hpp"
+
+// Reusable buffers for RateSimulator calls. Buffers only ever grow, so once a workspace
+// has seen the largest size it will be asked for, simulating and pricing through it does
+// no heap allocation. A workspace is not shared between threads; give each worker its own
+class SimulationWorkspace{
+    private:
+        std::vector<double> Rates;
+
+    public:
+        SimulationWorkspace() = default;
+
+        // Constructor that sizes the buffers up front
+        explicit SimulationWorkspace(std::size_t values){
+            reserve(values);
+        }
+
+        void reserve(std::size_t values){
+            if (values > Rates.capacity()){
+                IR_COUNT(Allocations, 1);
+                Rates.reserve(values);
+            }
+        }
+
+        // Rate buffer holding exactly `values` entries, reallocated only when it grows
+        std::vector<double>& rates(std::size_t values){
+            reserve(values);
+            Rates.resize(values);
+            return Rates;
+        }
+
+        std::size_t capacity() const { return Rates.capacity(); }
+};
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <cmath>
+#include <cstddef>
+#include <iostream>
 #include <vector>
+#include "Precision.hpp"
+#include "Instrumentation.hpp"
+#include "TimeGrid.hpp"
 
 // Class for interest rate swaps
 class Swaption {
@@ -11,7 +17,8 @@ private:
     double SwapLength;
 
     // Helper functions
-    double normalCDF(double x) const;
+    template<typename T>
+    static T normalCDF(const T& x);
     double calculatePVA( double strikeRate, double f, double expiryTime) const;
 
 public:
@@ -19,8 +26,136 @@ public:
     // Constructor for Swaption class
     Swaption(double StrikeRate, double Maturity, double Notional, double SwapLength);
 
-    // Calculate the price of the swaption using Black's formula
-    double price(const std::vector<double>& rates, double volatility, double timeStep, double f, bool isPayer) const;
+    double strikeRate() const { return StrikeRate; }
+    double maturity() const { return Maturity; }
+    double notional() const { return Notional; }
+    double swapLength() const { return SwapLength; }
+
+    // Calculate the price of the swaption using Black's formula, templated on the scalar
+    // type of the rates (double or float paths, or a Dual for sensitivities); volatility
+    // and the result are in the accumulator type
+    template<typename T>
+    Accumulator<T> price(const std::vector<T>& rates, const Accumulator<T>& volatility, double timeStep, double f, bool isPayer) const;
+
+    // Same as above on a raw path of numRates rates
+    template<typename T>
+    Accumulator<T> price(const T* rates, std::size_t numRates, const Accumulator<T>& volatility, double timeStep, double f, bool isPayer) const;
+
+    // Price off a path simulated on a time grid (one rate per node). The forward swap rate
+    // is the step-weighted mean of the rates at the nodes in (maturity, maturity + swapLength],
+    // which equals the uniform-grid average; both dates must be nodes of the grid
+    template<typename T>
+    Accumulator<T> price(const T* rates, const TimeGrid& grid, const Accumulator<T>& volatility, double f, bool isPayer) const;
+
+    // Price off observed running integrals of the short rate (ObservationSchedule): the forward
+    // swap rate is the mean rate over the swap period, (I(end) - I(maturity)) / swapLength
+    template<typename T>
+    Accumulator<T> priceFromIntegrals(const T* integrals, const TimeGrid& observed, const Accumulator<T>& volatility, double f, bool isPayer) const;
+
+    // Black's formula given the forward swap rate (the mean short rate over the swap period),
+    // for engines that accumulate that average themselves
+    template<typename T>
+    T priceFromForward(const T& forwardSwapRate, const T& volatility, double f, bool isPayer) const;
 
 };
 
+// Normal distribution function
+template<typename T>
+T Swaption::normalCDF(const T& x) {
+    return 0.5 * erfc(-x * sqrt(0.5));
+}
+
+// Price the swaption using Black's formula with simulated interest rates
+template<typename T>
+Accumulator<T> Swaption::price(const std::vector<T>& rates, const Accumulator<T>& volatility, double timeStep, double f, bool isPayer) const {
+    return price(rates.data(), rates.size(), volatility, timeStep, f, isPayer);
+}
+
+// Price the swaption from a raw path of rates
+template<typename T>
+Accumulator<T> Swaption::price(const T* rates, std::size_t numRates, const Accumulator<T>& volatility, double timeStep, double f, bool isPayer) const {
+    typedef Accumulator<T> Real;
+    IR_PROFILE_SCOPE(Payoff);
+
+    Real forwardSwapRate = 0.0;
+    int steps = static_cast<int>(Maturity / timeStep);
+    int swapSteps = static_cast<int>(SwapLength / timeStep);
+
+    // Ensure we have enough rates data
+    if (steps + swapSteps > static_cast<int>(numRates)) {
+        std::cerr << "Error: Insufficient rates data for pricing." << std::endl;
+        return 0.0;
+    }
+
+    // Calculate forward swap rate at maturity using rates in swap length 
+    for (int i = steps; i < steps + swapSteps; ++i) {
+        forwardSwapRate += rates[i];
+    }
+    forwardSwapRate /= swapSteps;
+
+    return priceFromForward(forwardSwapRate, volatility, f, isPayer);
+}
+
+// Price the swaption from a path on a time grid
+template<typename T>
+Accumulator<T> Swaption::price(const T* rates, const TimeGrid& grid, const Accumulator<T>& volatility, double f, bool isPayer) const {
+    typedef Accumulator<T> Real;
+    IR_PROFILE_SCOPE(Payoff);
+
+    int first = grid.index(Maturity);
+    int last = grid.index(Maturity + SwapLength);
+    if (first < 0 || last <= first) {
+        std::cerr << "Error: Swaption dates are not nodes of the time grid." << std::endl;
+        return 0.0;
+    }
+
+    Real forwardSwapRate = 0.0;
+    for (int i = first + 1; i <= last; ++i) {
+        forwardSwapRate += rates[i] * grid.step(i);
+    }
+    forwardSwapRate /= grid.time(last) - grid.time(first);
+
+    return priceFromForward(forwardSwapRate, volatility, f, isPayer);
+}
+
+// Price the swaption from running integrals at observed dates
+template<typename T>
+Accumulator<T> Swaption::priceFromIntegrals(const T* integrals, const TimeGrid& observed, const Accumulator<T>& volatility, double f, bool isPayer) const {
+    typedef Accumulator<T> Real;
+    IR_PROFILE_SCOPE(Payoff);
+
+    int first = observed.index(Maturity);
+    int last = observed.index(Maturity + SwapLength);
+    if (first < 0 || last <= first) {
+        std::cerr << "Error: Swaption dates are not observed." << std::endl;
+        return 0.0;
+    }
+
+    Real forwardSwapRate = (Real(integrals[last]) - Real(integrals[first])) / (observed.time(last) - observed.time(first));
+    return priceFromForward(forwardSwapRate, volatility, f, isPayer);
+}
+
+// Black's formula on a given forward swap rate
+template<typename T>
+T Swaption::priceFromForward(const T& forwardSwapRate, const T& volatility, double f, bool isPayer) const {
+    typedef T Real;
+    using std::erfc;
+    using std::log;
+    using std::pow;
+    using std::sqrt;
+
+    Real d1 = (log(forwardSwapRate / StrikeRate) + 0.5 * pow(volatility, 2) * Maturity) /
+                (volatility * sqrt(Maturity));
+    Real d2 = d1 - volatility * sqrt(Maturity);
+
+    double annuityFactor = calculatePVA(StrikeRate, f, Maturity);
+
+    Real presentValue;
+    if (isPayer) {
+        presentValue = Notional * annuityFactor * (forwardSwapRate * normalCDF(d1) - StrikeRate * normalCDF(d2));
+    } else {
+        presentValue = Notional * annuityFactor * (StrikeRate * normalCDF(-d2) - forwardSwapRate * normalCDF(-d1));
+    }
+
+    return presentValue;
+}
@@ -0,0 +1,269 @@
+#include "TiledSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "ParallelFor.hpp"
+#include "Instrumentation.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    // Draws per path: the generator and distribution state of every path in a group
+    struct PathStreams{
+        std::vector<std::default_random_engine> Engines;
+        std::vector<std::normal_distribution<double>> Distributions;
+    };
+
+    // Steps one path of a model whose step is a static template
+    template<typename Model>
+    struct StaticStepper{
+        double MeanReversion, LongTermMean, Volatility, TimeStep;
+        double operator()(double rate, unsigned int, double dw) const{
+            return Model::template step<double, double>(rate, MeanReversion, LongTermMean, Volatility, TimeStep, dw);
+        }
+    };
+
+    // Any other model, through its virtual step
+    struct VirtualStepper{
+        const InterestRateModel* Model;
+        double TimeStep;
+        double operator()(double rate, unsigned int i, double dw) const{
+            return Model->nextRate(rate, i * TimeStep, TimeStep, dw);
+        }
+    };
+
+    // Advance paths [first, first + count) tile by tile; onStep(i, rates) sees the rates of
+    // the whole group after step i
+    template<typename Stepper, typename OnStep>
+    void runGroup(const Stepper& stepper, double InitialRate, unsigned int seed, unsigned int first, unsigned int count,
+                  unsigned int steps, unsigned int tileSteps, std::vector<double>& rates, std::vector<double>& normals,
+                  PathStreams& streams, OnStep onStep){
+        streams.Engines.resize(count);
+        streams.Distributions.resize(count);
+        for (unsigned int p = 0; p < count; ++p){
+            streams.Engines[p].seed(TiledSimulator::pathSeed(seed, first + p));
+            streams.Distributions[p] = std::normal_distribution<double>(0.0, 1.0);
+        }
+        rates.assign(count, InitialRate);
+        normals.resize(static_cast<std::size_t>(count) * tileSteps);
+
+        for (unsigned int start = 0; start < steps; start += tileSteps){
+            unsigned int length = std::min(tileSteps, steps - start);
+            {
+                IR_PROFILE_SCOPE(Rng);
+                for (unsigned int p = 0; p < count; ++p){
+                    std::default_random_engine& engine = streams.Engines[p];
+                    std::normal_distribution<double>& distribution = streams.Distributions[p];
+                    for (unsigned int s = 0; s < length; ++s){
+                        normals[static_cast<std::size_t>(s) * count + p] = distribution(engine);
+                    }
+                }
+            }
+            IR_PROFILE_SCOPE(Stepping);
+            for (unsigned int s = 0; s < length; ++s){
+                const double* dw = normals.data() + static_cast<std::size_t>(s) * count;
+                double* r = rates.data();
+                for (unsigned int p = 0; p < count; ++p){
+                    r[p] = stepper(r[p], start + s, dw[p]);
+                }
+                onStep(start + s, r);
+            }
+        }
+        IR_COUNT(Paths, count);
+        IR_COUNT(Steps, static_cast<std::uint64_t>(count) * steps);
+    }
+
+    // Call fn with the stepper for the model
+    template<typename Fn>
+    void withStepper(const InterestRateModel& model, double timeStep, Fn fn){
+        if (dynamic_cast<const VasicekModel*>(&model)){
+            fn(StaticStepper<VasicekModel>{model.getMeanReversion(), model.getLongTermMean(), model.getVolatility(), timeStep});
+        }
+        else if (dynamic_cast<const CIRModel*>(&model)){
+            fn(StaticStepper<CIRModel>{model.getMeanReversion(), model.getLongTermMean(), model.getVolatility(), timeStep});
+        }
+        else{
+            fn(VirtualStepper{&model, timeStep});
+        }
+    }
+
+    // Parse sysfs sizes such as "2048K"
+    std::size_t parseSize(const std::string& text){
+        std::size_t value = std::strtoul(text.c_str(), nullptr, 10);
+        if (text.find('K') != std::string::npos) value <<= 10;
+        if (text.find('M') != std::string::npos) value <<= 20;
+        return value;
+    }
+}
+
+// Constructor for TiledSimulator class
+TiledSimulator::TiledSimulator(unsigned int numPaths, double timeStep, unsigned int steps, unsigned int seed,
+                               unsigned int threads)
+    : NumPaths(numPaths), TimeStep(timeStep), Steps(steps), Seed(seed), Threads(resolveThreadCount(threads)),
+      Tile(autoTile(steps)) {}
+
+std::size_t TiledSimulator::l2CacheBytes(){
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0) return static_cast<std::size_t>(size);
+#endif
+    for (int index = 0; index < 8; ++index){
+        std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index);
+        std::ifstream levelFile(dir + "/level"), typeFile(dir + "/type"), sizeFile(dir + "/size");
+        int level = 0;
+        std::string type, size;
+        if (!(levelFile >> level) || !(typeFile >> type) || !(sizeFile >> size)) continue;
+        if (level == 2 && type != "Instruction") return parseSize(size);
+    }
+    return 256u << 10;
+}
+
+// Up to 64 steps per tile; as many paths as fit half the cache alongside their state
+TileShape TiledSimulator::autoTile(unsigned int steps, std::size_t cacheBytes){
+    TileShape tile;
+    tile.Steps = std::max(1u, std::min(steps, 64u));
+    std::size_t bytesPerPath = tile.Steps * sizeof(double) + sizeof(double)
+                               + sizeof(std::default_random_engine) + sizeof(std::normal_distribution<double>);
+    std::size_t paths = cacheBytes / 2 / bytesPerPath;
+    tile.Paths = static_cast<unsigned int>(std::max<std::size_t>(8, paths / 8 * 8));
+    return tile;
+}
+
+void TiledSimulator::setTile(TileShape tile){
+    Tile.Paths = std::max(8u, (tile.Paths + 7) / 8 * 8);
+    Tile.Steps = std::max(1u, tile.Steps);
+}
+
+// Mix the path index into the seed so neighbouring paths get unrelated streams
+unsigned int TiledSimulator::pathSeed(unsigned int seed, std::size_t path){
+    std::uint64_t x = (static_cast<std::uint64_t>(seed) << 32) ^ (path + 0x9E3779B97F4A7C15ull);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<unsigned int>(x ^ (x >> 31));
+}
+
+std::vector<double> TiledSimulator::price(const InterestRateModel& model, double InitialRate,
+                                          const std::vector<Bond>& bonds, const std::vector<SwaptionTrade>& swaptions) const{
+    std::size_t numBonds = bonds.size();
+    std::size_t numInstruments = numBonds + swaptions.size();
+
+    // Bond cash flows as (step, bond) events in step order
+    struct FlowEvent{
+        unsigned int Step;
+        std::size_t Bond;
+        double Amount;
+        double Time;
+    };
+    std::vector<FlowEvent> flows;
+    for (std::size_t k = 0; k < numBonds; ++k){
+        for (const CashFlow& cf : bonds[k].cashFlowSchedule(TimeStep, Steps)){
+            flows.push_back({static_cast<unsigned int>(cf.RateIndex), k, cf.Amount, cf.Time});
+        }
+    }
+    std::stable_sort(flows.begin(), flows.end(), [](const FlowEvent& a, const FlowEvent& b){ return a.Step < b.Step; });
+
+    // Averaging window of each swaption, with the same indexing as Swaption::price
+    std::vector<unsigned int> windowStart(swaptions.size()), windowLength(swaptions.size());
+    std::vector<bool> valid(swaptions.size());
+    for (std::size_t k = 0; k < swaptions.size(); ++k){
+        const Swaption& swaption = swaptions[k].Instrument;
+        int start = static_cast<int>(swaption.maturity() / TimeStep);
+        int length = static_cast<int>(swaption.swapLength() / TimeStep);
+        valid[k] = length > 0 && start + length <= static_cast<int>(Steps);
+        if (!valid[k]){
+            std::cerr << "Error: Insufficient rates data for pricing." << std::endl;
+        }
+        windowStart[k] = static_cast<unsigned int>(std::max(start, 0));
+        windowLength[k] = static_cast<unsigned int>(std::max(length, 0));
+    }
+
+    std::size_t numGroups = (NumPaths + Tile.Paths - 1) / Tile.Paths;
+    std::vector<double> partial(numGroups * numInstruments, 0.0);
+
+    // Per-worker buffers, sized on first use and reused across groups
+    struct Scratch{
+        std::vector<double> Rates, Normals, Values;
+        PathStreams Streams;
+    };
+    std::vector<Scratch> scratch(Threads);
+
+    withStepper(model, TimeStep, [&](const auto& stepper){
+        parallelFor(numGroups, Threads, [&](std::size_t g, unsigned int worker){
+            unsigned int first = static_cast<unsigned int>(g * Tile.Paths);
+            unsigned int count = std::min(Tile.Paths, NumPaths - first);
+            TraceScope trace("tile group", "generate", count);
+            Scratch& s = scratch[worker];
+
+            // Values[k * count + p]: discounted flows of bond k, or the rate sum of swaption k
+            s.Values.assign(numInstruments * count, 0.0);
+            std::size_t nextFlow = 0;
+            runGroup(stepper, InitialRate, Seed, first, count, Steps, Tile.Steps, s.Rates, s.Normals, s.Streams,
+                     [&](unsigned int i, const double* r){
+                for (; nextFlow < flows.size() && flows[nextFlow].Step == i; ++nextFlow){
+                    const FlowEvent& flow = flows[nextFlow];
+                    double* value = s.Values.data() + flow.Bond * count;
+                    for (unsigned int p = 0; p < count; ++p){
+                        value[p] += flow.Amount * std::exp(-r[p] * flow.Time);
+                    }
+                }
+                for (std::size_t k = 0; k < swaptions.size(); ++k){
+                    if (i >= windowStart[k] && i < windowStart[k] + windowLength[k]){
+                        double* sum = s.Values.data() + (numBonds + k) * count;
+                        for (unsigned int p = 0; p < count; ++p) sum[p] += r[p];
+                    }
+                }
+            });
+
+            IR_PROFILE_SCOPE(Payoff);
+            double* sums = partial.data() + g * numInstruments;
+            for (std::size_t k = 0; k < numBonds; ++k){
+                const double* value = s.Values.data() + k * count;
+                for (unsigned int p = 0; p < count; ++p) sums[k] += value[p];
+            }
+            for (std::size_t k = 0; k < swaptions.size(); ++k){
+                if (!valid[k]) continue;
+                const SwaptionTrade& trade = swaptions[k];
+                const double* sum = s.Values.data() + (numBonds + k) * count;
+                for (unsigned int p = 0; p < count; ++p){
+                    double forward = sum[p] / windowLength[k];
+                    sums[numBonds + k] += trade.Instrument.priceFromForward(forward, trade.Volatility, trade.Frequency, trade.IsPayer);
+                }
+            }
+        });
+    });
+
+    // Reduce groups in order so results do not depend on the thread count
+    std::vector<double> prices(numInstruments, 0.0);
+    for (std::size_t g = 0; g < numGroups; ++g){
+        for (std::size_t k = 0; k < numInstruments; ++k) prices[k] += partial[g * numInstruments + k];
+    }
+    for (double& price : prices){
+        price = NumPaths == 0 ? 0.0 : price / NumPaths;
+    }
+    return prices;
+}
+
+void TiledSimulator::simulate(const InterestRateModel& model, double InitialRate, double* out) const{
+    std::size_t numGroups = (NumPaths + Tile.Paths - 1) / Tile.Paths;
+    withStepper(model, TimeStep, [&](const auto& stepper){
+        parallelFor(numGroups, Threads, [&](std::size_t g, unsigned int){
+            unsigned int first = static_cast<unsigned int>(g * Tile.Paths);
+            unsigned int count = std::min(Tile.Paths, NumPaths - first);
+            std::vector<double> rates, normals;
+            PathStreams streams;
+            runGroup(stepper, InitialRate, Seed, first, count, Steps, Tile.Steps, rates, normals, streams,
+                     [&](unsigned int i, const double* r){
+                for (unsigned int p = 0; p < count; ++p){
+                    out[static_cast<std::size_t>(first + p) * Steps + i] = r[p];
+                }
+            });
+        });
+    });
+}
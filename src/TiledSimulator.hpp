@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "InterestRateModel.hpp"
+#include "Bond.hpp"
+#include "ScenarioEngine.hpp"
+
+// A group of paths advanced together over a run of steps
+struct TileShape{
+    unsigned int Paths;
+    unsigned int Steps;
+};
+
+// Cache-blocked Monte Carlo. Paths are processed in groups of Tile.Paths; within a group
+// the normals for Tile.Steps steps are drawn into a step-major tile, every path is
+// advanced one step at a time (an inner loop over paths the compiler can vectorise), and
+// payoffs are accumulated as each step completes, so the tile stays in L2 and no full path
+// is ever stored. Each path has its own normal stream, so paths are the same for any
+// tile shape or thread count. The default tile is sized from the L2 cache of the CPU
+class TiledSimulator{
+    private:
+        unsigned int NumPaths;
+        double TimeStep;
+        unsigned int Steps;
+        unsigned int Seed;
+        unsigned int Threads;
+        TileShape Tile;
+
+    public:
+        // Constructor for TiledSimulator class; threads = 0 uses all cores
+        TiledSimulator(unsigned int numPaths, double timeStep, unsigned int steps, unsigned int seed,
+                       unsigned int threads = 0);
+
+        // Per-core L2 size from sysconf or sysfs, 256 KB if neither reports it
+        static std::size_t l2CacheBytes();
+
+        // Tile whose normals and path state fill about half of cacheBytes
+        static TileShape autoTile(unsigned int steps, std::size_t cacheBytes = l2CacheBytes());
+
+        // Override the tile shape (paths are rounded up to a multiple of 8)
+        void setTile(TileShape tile);
+        TileShape tile() const { return Tile; }
+
+        // Mean price of each bond, then each swaption, with payoffs accumulated per tile
+        std::vector<double> price(const InterestRateModel& model, double InitialRate,
+                                  const std::vector<Bond>& bonds, const std::vector<SwaptionTrade>& swaptions) const;
+
+        // Write every path to out (NumPaths x Steps, path-major), e.g. for checking
+        void simulate(const InterestRateModel& model, double InitialRate, double* out) const;
+
+        // Seed of path p's normal stream
+        static unsigned int pathSeed(unsigned int seed, std::size_t path);
+};
@@ -0,0 +1,72 @@
+#include "TimeGrid.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    double tolerance(double t){
+        return TimeGrid::Tolerance * std::max(1.0, std::abs(t));
+    }
+}
+
+// Constructor for TimeGrid class
+TimeGrid::TimeGrid(std::vector<double> dates, double maxStep){
+    std::sort(dates.begin(), dates.end());
+
+    double previous = 0.0;
+    for (double t : dates){
+        if (t - previous <= tolerance(t)) continue;
+
+        double gap = t - previous;
+        std::size_t pieces = 1;
+        if (maxStep > 0.0 && gap > maxStep){
+            pieces = static_cast<std::size_t>(std::ceil(gap / maxStep - Tolerance));
+        }
+        for (std::size_t k = 1; k < pieces; ++k){
+            Times.push_back(previous + gap * k / pieces);
+        }
+        Times.push_back(t);
+        previous = t;
+    }
+
+    Steps.resize(Times.size());
+    for (std::size_t i = 0; i < Times.size(); ++i){
+        Steps[i] = Times[i] - (i == 0 ? 0.0 : Times[i - 1]);
+    }
+}
+
+// Uniform grid; steps are exactly timeStep so simulations match the timeStep interfaces
+TimeGrid TimeGrid::uniform(double timeStep, unsigned int steps){
+    TimeGrid grid;
+    grid.Times.resize(steps);
+    grid.Steps.assign(steps, timeStep);
+    for (unsigned int i = 0; i < steps; ++i){
+        grid.Times[i] = (i + 1) * timeStep;
+    }
+    return grid;
+}
+
+// Grid through every date the instruments are priced off
+TimeGrid TimeGrid::forInstruments(const std::vector<Bond>& bonds, const std::vector<Swaption>& swaptions,
+                                  double maxStep, const std::vector<double>& extraDates){
+    std::vector<double> dates = extraDates;
+    for (const Bond& bond : bonds){
+        for (const CashFlow& cf : bond.cashFlows()){
+            dates.push_back(cf.Time);
+        }
+    }
+    for (const Swaption& swaption : swaptions){
+        dates.push_back(swaption.maturity());
+        dates.push_back(swaption.maturity() + swaption.swapLength());
+    }
+    return TimeGrid(dates, maxStep);
+}
+
+// Binary search for the node within rounding of t
+int TimeGrid::index(double t) const{
+    double tol = tolerance(t);
+    auto it = std::lower_bound(Times.begin(), Times.end(), t - tol);
+    if (it == Times.end() || *it > t + tol) return -1;
+    return static_cast<int>(it - Times.begin());
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class Bond;
+class Swaption;
+
+// Simulation dates 0 < t_1 < ... < t_n. Node i holds the rate at t_i, reached from t_{i-1}
+// (or 0) by a step of length step(i). Grids are built from the dates instruments need,
+// optionally refined so no step exceeds a maximum, and payoffs look nodes up by time
+// instead of truncating time / timeStep
+class TimeGrid{
+    private:
+        std::vector<double> Times;
+        std::vector<double> Steps;
+
+    public:
+        // Constructor for an empty grid
+        TimeGrid() = default;
+
+        // Grid through the given dates (sorted, with non-positive and coincident dates
+        // dropped); when maxStep > 0 each gap is split into equal steps no longer than maxStep
+        explicit TimeGrid(std::vector<double> dates, double maxStep = 0.0);
+
+        // steps nodes spaced exactly timeStep apart, the grid of simulatePaths(timeStep, steps)
+        static TimeGrid uniform(double timeStep, unsigned int steps);
+
+        // Cash-flow dates of the bonds, exercise and swap end dates of the swaptions, and
+        // any extra dates (e.g. Bermudan exercise dates)
+        static TimeGrid forInstruments(const std::vector<Bond>& bonds, const std::vector<Swaption>& swaptions,
+                                       double maxStep = 0.0, const std::vector<double>& extraDates = {});
+
+        std::size_t size() const { return Times.size(); }
+        double time(std::size_t i) const { return Times[i]; }
+        double step(std::size_t i) const { return Steps[i]; }
+        double end() const { return Times.empty() ? 0.0 : Times.back(); }
+        const std::vector<double>& times() const { return Times; }
+
+        // Index of the node at time t, or -1 if no node lies within rounding of t
+        int index(double t) const;
+
+        // Two dates closer than this (relative to max(1, t)) are the same node
+        static constexpr double Tolerance = 1e-9;
+};
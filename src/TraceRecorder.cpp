@@ -0,0 +1,95 @@
+#include "TraceRecorder.hpp"
+#include <cstdio>
+#include <iostream>
+
+thread_local TraceRecorder::Release TraceRecorder::Releaser;
+
+// Allocate or reuse a buffer for the calling thread
+TraceRecorder::ThreadBuffer* TraceRecorder::registerThread(){
+    ThreadBuffer* buffer;
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (!FreeBuffers.empty()){
+            buffer = FreeBuffers.back();
+            FreeBuffers.pop_back();
+        }
+        else{
+            Buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = Buffers.back().get();
+            buffer->Id = static_cast<unsigned int>(Buffers.size());
+            buffer->Events.resize(Capacity);
+        }
+    }
+    Releaser.Buffer = buffer;
+    return buffer;
+}
+
+void TraceRecorder::releaseThread(ThreadBuffer* buffer){
+    std::lock_guard<std::mutex> lock(Mutex);
+    FreeBuffers.push_back(buffer);
+    Local = nullptr;
+}
+
+// Clear the buffers, resize them if the capacity changed, and reset the clock
+void TraceRecorder::start(std::size_t eventsPerThread){
+    std::lock_guard<std::mutex> lock(Mutex);
+    Capacity = eventsPerThread;
+    for (std::unique_ptr<ThreadBuffer>& buffer : Buffers){
+        buffer->Events.resize(Capacity);
+        buffer->Count = 0;
+        buffer->Dropped = 0;
+    }
+    Origin = std::chrono::steady_clock::now();
+    Enabled.store(true, std::memory_order_relaxed);
+}
+
+std::size_t TraceRecorder::eventCount(){
+    std::lock_guard<std::mutex> lock(Mutex);
+    std::size_t count = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : Buffers) count += buffer->Count;
+    return count;
+}
+
+std::size_t TraceRecorder::droppedCount(){
+    std::lock_guard<std::mutex> lock(Mutex);
+    std::size_t count = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : Buffers) count += buffer->Dropped;
+    return count;
+}
+
+// Complete ("X") events with microsecond timestamps, plus a name for each thread row
+bool TraceRecorder::write(const std::string& filename){
+    std::FILE* file = std::fopen(filename.c_str(), "w");
+    if (file == nullptr){
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(Mutex);
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : Buffers){
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                     first ? "" : ",\n", buffer->Id, buffer->Id);
+        first = false;
+        for (std::size_t i = 0; i < buffer->Count; ++i){
+            const TraceEvent& e = buffer->Events[i];
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                         e.Name, e.Category, buffer->Id, e.Begin * 1e-3, (e.End - e.Begin) * 1e-3);
+            if (e.Items >= 0){
+                std::fprintf(file, ",\"args\":{\"items\":%lld}", static_cast<long long>(e.Items));
+            }
+            std::fputc('}', file);
+        }
+        if (buffer->Dropped > 0){
+            std::cerr << "Trace buffer " << buffer->Id << " dropped " << buffer->Dropped << " events." << std::endl;
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+
+    if (std::fclose(file) != 0){
+        std::cerr << "Failed to properly write the file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
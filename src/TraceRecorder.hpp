@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One completed span on a thread; Name and Category must be string literals
+struct TraceEvent{
+    const char* Name;
+    const char* Category;
+    std::int64_t Begin;     // nanoseconds since start()
+    std::int64_t End;
+    std::int64_t Items;     // batch size or byte count, -1 if none
+};
+
+// Records begin/end spans from every thread and dumps them as Chrome trace JSON
+// (chrome://tracing or ui.perfetto.dev). Each thread appends to its own fixed-size
+// buffer without locking; events past the capacity are counted as dropped. Recording
+// is off until start(), and a TraceScope then costs one relaxed load when it is off
+class TraceRecorder{
+    public:
+        // Clear previous events and begin recording. Call when no workers are running
+        static void start(std::size_t eventsPerThread = 1 << 16);
+
+        static void stop(){ Enabled.store(false, std::memory_order_relaxed); }
+
+        static bool enabled(){ return Enabled.load(std::memory_order_relaxed); }
+
+        // Nanoseconds since start()
+        static std::int64_t now(){
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Origin).count();
+        }
+
+        static void record(const char* name, const char* category, std::int64_t begin, std::int64_t end, std::int64_t items){
+            ThreadBuffer& buffer = local();
+            if (buffer.Count < buffer.Events.size()){
+                buffer.Events[buffer.Count++] = {name, category, begin, end, items};
+            }
+            else{
+                ++buffer.Dropped;
+            }
+        }
+
+        // Write every recorded event as Chrome trace JSON. Call when no workers are running
+        static bool write(const std::string& filename);
+
+        // Number of recorded and dropped events over all threads
+        static std::size_t eventCount();
+        static std::size_t droppedCount();
+
+    private:
+        struct ThreadBuffer{
+            unsigned int Id = 0;
+            std::vector<TraceEvent> Events;
+            std::size_t Count = 0;
+            std::size_t Dropped = 0;
+        };
+
+        static ThreadBuffer& local(){
+            if (Local == nullptr) Local = registerThread();
+            return *Local;
+        }
+
+        static ThreadBuffer* registerThread();
+        static void releaseThread(ThreadBuffer* buffer);
+
+        static inline std::atomic<bool> Enabled{false};
+        static inline std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+        static inline std::size_t Capacity = 1 << 16;
+        static inline thread_local ThreadBuffer* Local = nullptr;
+
+        // Hands the buffer back when its thread exits; a later thread continues it, so
+        // trace rows are worker slots rather than OS threads
+        struct Release{
+            ThreadBuffer* Buffer = nullptr;
+            ~Release(){ if (Buffer != nullptr) releaseThread(Buffer); }
+        };
+        static thread_local Release Releaser;
+
+        static inline std::mutex Mutex;
+        static inline std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+        static inline std::vector<ThreadBuffer*> FreeBuffers;
+};
+
+// Records the span between construction and destruction when tracing is on
+class TraceScope{
+    private:
+        const char* Name;
+        const char* Category;
+        std::int64_t Items;
+        std::int64_t Begin;
+        bool Active;
+
+    public:
+        TraceScope(const char* name, const char* category, std::int64_t items = -1)
+            : Name(name), Category(category), Items(items), Begin(0), Active(TraceRecorder::enabled()){
+            if (Active) Begin = TraceRecorder::now();
+        }
+
+        ~TraceScope(){
+            if (Active) TraceRecorder::record(Name, Category, Begin, TraceRecorder::now(), Items);
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+};
@@ -0,0 +1,250 @@
+#include "TrinomialTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+// Build the lattice
+TrinomialTree::TrinomialTree(const InterestRateModel& model, double InitialRate, double horizon, unsigned int steps)
+    : TimeStep(horizon / std::max(steps, 1u)), Steps(std::max(steps, 1u)) {
+    Dx = model.latticeVolatility() * std::sqrt(3.0 * TimeStep);
+    double x0 = model.latticeState(InitialRate);
+
+    // Lowest index allowed by the state space (x >= 0 for transformed models)
+    bool bounded = model.latticeState(-1.0) >= 0.0;
+    long lowest = bounded ? static_cast<long>(std::ceil(-x0 / Dx - 1e-12)) : std::numeric_limits<long>::min() / 2;
+
+    LevelOffset.push_back(0);
+    std::vector<long> levelJ = {0};
+    for (unsigned int i = 0; i <= Steps; ++i){
+        std::size_t n = levelJ.size();
+        for (std::size_t k = 0; k < n; ++k){
+            Rates.push_back(model.latticeRate(x0 + levelJ[k] * Dx));
+        }
+        LevelOffset.push_back(Rates.size());
+        if (i == Steps){
+            break;
+        }
+
+        // Branch each node around the nearest node to its expected next state
+        std::vector<long> centre(n);
+        long nextMin = std::numeric_limits<long>::max();
+        long nextMax = std::numeric_limits<long>::min();
+        double t = i * TimeStep;
+        for (std::size_t k = 0; k < n; ++k){
+            double x = x0 + levelJ[k] * Dx;
+            double expected = x + model.latticeDrift(x, t) * TimeStep;
+            long c = static_cast<long>(std::lround((expected - x0) / Dx));
+            c = std::max(c, lowest + 1);
+            double eta = (expected - (x0 + c * Dx)) / Dx;
+
+            // Probabilities matching the mean and variance of the step
+            double up = 1.0 / 6.0 + 0.5 * (eta * eta + eta);
+            double mid = 2.0 / 3.0 - eta * eta;
+            double down = 1.0 / 6.0 + 0.5 * (eta * eta - eta);
+            if (down < 0 || mid < 0){
+                // Only near a reflecting boundary: clip and renormalise
+                up = std::max(up, 0.0);
+                mid = std::max(mid, 0.0);
+                down = std::max(down, 0.0);
+                double total = up + mid + down;
+                up /= total; mid /= total; down /= total;
+            }
+            Up.push_back(up);
+            Middle.push_back(mid);
+            Down.push_back(down);
+            centre[k] = c;
+            nextMin = std::min(nextMin, c - 1);
+            nextMax = std::max(nextMax, c + 1);
+        }
+        for (std::size_t k = 0; k < n; ++k){
+            Child.push_back(static_cast<std::size_t>(centre[k] - nextMin));
+        }
+
+        levelJ.clear();
+        for (long j = nextMin; j <= nextMax; ++j){
+            levelJ.push_back(j);
+        }
+    }
+
+    Shift.assign(Steps + 1, 0.0);
+    Discounts.resize(Rates.size());
+    for (unsigned int i = 0; i <= Steps; ++i){
+        updateDiscounts(i);
+    }
+
+    if (model.initialCurve() != nullptr){
+        fitToCurve(*model.initialCurve());
+    }
+}
+
+// One-period discount factors of a level
+void TrinomialTree::updateDiscounts(unsigned int level){
+    for (std::size_t k = LevelOffset[level]; k < LevelOffset[level + 1]; ++k){
+        Discounts[k] = std::exp(-(Rates[k] + Shift[level]) * TimeStep);
+    }
+}
+
+// Forward induction of Arrow-Debreu prices, solving each level's shift in closed form
+void TrinomialTree::fitToCurve(const YieldCurve& curve){
+    std::vector<double> times(Steps);
+    for (unsigned int i = 0; i < Steps; ++i){
+        times[i] = (i + 1) * TimeStep;
+    }
+    std::vector<double> target = curve.discountFactors(times);
+
+    std::vector<double> q = {1.0};
+    for (unsigned int i = 0; i < Steps; ++i){
+        std::size_t offset = LevelOffset[i];
+        std::size_t n = levelSize(i);
+
+        double sum = 0.0;
+        for (std::size_t k = 0; k < n; ++k){
+            sum += q[k] * std::exp(-Rates[offset + k] * TimeStep);
+        }
+        Shift[i] = std::log(sum / target[i]) / TimeStep;
+        updateDiscounts(i);
+
+        std::vector<double> next(levelSize(i + 1), 0.0);
+        for (std::size_t k = 0; k < n; ++k){
+            double value = q[k] * Discounts[offset + k];
+            std::size_t c = Child[offset + k];
+            next[c + 1] += value * Up[offset + k];
+            next[c] += value * Middle[offset + k];
+            next[c - 1] += value * Down[offset + k];
+        }
+        q.swap(next);
+    }
+}
+
+// Discounted expectation of next-level values for every node of a level
+void TrinomialTree::rollBack(unsigned int level, const std::vector<double>& next, std::vector<double>& out) const{
+    std::size_t offset = LevelOffset[level];
+    std::size_t n = levelSize(level);
+    out.resize(n);
+
+    const double* up = &Up[offset];
+    const double* mid = &Middle[offset];
+    const double* down = &Down[offset];
+    const double* disc = &Discounts[offset];
+    const std::size_t* child = &Child[offset];
+    for (std::size_t k = 0; k < n; ++k){
+        const double* v = &next[child[k]];
+        out[k] = disc[k] * (up[k] * v[1] + mid[k] * v[0] + down[k] * v[-1]);
+    }
+}
+
+// Nearest level to a date, or -1 if beyond the tree
+int TrinomialTree::levelOf(double time) const{
+    long level = std::lround(time / TimeStep);
+    if (level < 0 || level > static_cast<long>(Steps)){
+        std::cerr << "Date " << time << " is outside the tree." << std::endl;
+        return -1;
+    }
+    return static_cast<int>(level);
+}
+
+// Price of a zero-coupon bond
+double TrinomialTree::priceZeroCouponBond(double maturity) const{
+    int last = levelOf(maturity);
+    if (last < 0){
+        return 0.0;
+    }
+    std::vector<double> values(levelSize(last), 1.0);
+    std::vector<double> scratch;
+    for (int i = last - 1; i >= 0; --i){
+        rollBack(i, values, scratch);
+        values.swap(scratch);
+    }
+    return values[0];
+}
+
+// Price of a straight bond
+double TrinomialTree::priceBond(const Bond& bond) const{
+    return priceCallableBond(bond, {}, 0.0);
+}
+
+// Price of a callable bond
+double TrinomialTree::priceCallableBond(const Bond& bond, const std::vector<double>& callDates, double callPrice) const{
+    std::vector<double> flowsAt(Steps + 1, 0.0);
+    for (const CashFlow& cf : bond.cashFlows()){
+        int level = levelOf(cf.Time);
+        if (level < 0){
+            return 0.0;
+        }
+        flowsAt[level] += cf.Amount;
+    }
+    std::vector<bool> callable(Steps + 1, false);
+    for (double t : callDates){
+        int level = levelOf(t);
+        if (level >= 0) callable[level] = true;
+    }
+
+    int last = Steps;
+    while (last > 0 && flowsAt[last] == 0.0) --last;
+
+    std::vector<double> values(levelSize(last), flowsAt[last]);
+    std::vector<double> scratch;
+    for (int i = last - 1; i >= 0; --i){
+        rollBack(i, values, scratch);
+        values.swap(scratch);
+
+        // Issuer redeems when the bond is worth more than the call price; the coupon due
+        // on the call date is paid either way
+        if (callable[i]){
+            for (double& v : values) v = std::min(v, callPrice);
+        }
+        if (flowsAt[i] != 0.0){
+            for (double& v : values) v += flowsAt[i];
+        }
+    }
+    return values[0];
+}
+
+// Price of a Bermudan swaption
+double TrinomialTree::priceBermudanSwaption(const std::vector<double>& exerciseDates, double swapEnd, double fixedRate,
+                                            double frequency, double notional, bool isPayer) const{
+    int last = levelOf(swapEnd);
+    if (last < 0 || exerciseDates.empty()){
+        return 0.0;
+    }
+
+    // Fixed leg plus notional, as flows per level
+    std::vector<double> flowsAt(Steps + 1, 0.0);
+    double coupon = notional * fixedRate / frequency;
+    for (double t = swapEnd; t > 1e-12; t -= 1.0 / frequency){
+        int level = levelOf(t);
+        if (level >= 0) flowsAt[level] += coupon;
+    }
+    flowsAt[last] += notional;
+
+    std::vector<bool> exercisable(Steps + 1, false);
+    for (double t : exerciseDates){
+        int level = levelOf(t);
+        if (level >= 0 && level < last) exercisable[level] = true;
+    }
+
+    // Roll back the fixed bond and the option together. On an exercise date the swap
+    // entered is worth notional minus the fixed bond of the remaining payments (the
+    // floating leg is worth par on a reset date)
+    std::vector<double> fixedBond(levelSize(last), flowsAt[last]);
+    std::vector<double> option(levelSize(last), 0.0);
+    std::vector<double> scratch;
+    for (int i = last - 1; i >= 0; --i){
+        rollBack(i, fixedBond, scratch);
+        fixedBond.swap(scratch);
+        rollBack(i, option, scratch);
+        option.swap(scratch);
+
+        if (exercisable[i]){
+            for (std::size_t k = 0; k < option.size(); ++k){
+                double swapValue = isPayer ? notional - fixedBond[k] : fixedBond[k] - notional;
+                option[k] = std::max(option[k], swapValue);
+            }
+        }
+        if (flowsAt[i] != 0.0){
+            for (double& v : fixedBond) v += flowsAt[i];
+        }
+    }
+    return option[0];
+}
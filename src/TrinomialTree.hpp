@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include "InterestRateModel.hpp"
+#include "Bond.hpp"
+#include "YieldCurve.hpp"
+
+// Class for a recombining Hull-White style trinomial lattice on the model's lattice state.
+// Nodes are stored level by level in flat arrays (rates, discounts, branch probabilities and
+// the middle child of each node), so backward induction streams through contiguous memory.
+// Build one tree per model and horizon and price every trade on it. Event dates are snapped
+// to the nearest tree level
+class TrinomialTree{
+    private:
+        double TimeStep;
+        unsigned int Steps;
+        double Dx;
+
+        // Level i holds nodes [LevelOffset[i], LevelOffset[i + 1])
+        std::vector<std::size_t> LevelOffset;
+        std::vector<double> Rates;
+        std::vector<double> Discounts;
+        std::vector<double> Up;
+        std::vector<double> Middle;
+        std::vector<double> Down;
+        std::vector<std::size_t> Child;     // middle child, as an index within the next level
+        std::vector<double> Shift;          // per-level rate shift from curve fitting
+
+        std::size_t levelSize(unsigned int level) const { return LevelOffset[level + 1] - LevelOffset[level]; }
+        void rollBack(unsigned int level, const std::vector<double>& next, std::vector<double>& out) const;
+        int levelOf(double time) const;
+        void updateDiscounts(unsigned int level);
+
+    public:
+        // Constructor for TrinomialTree class covering [0, horizon] in `steps` steps. Models
+        // with an initial curve (Hull-White) are fitted to it automatically
+        TrinomialTree(const InterestRateModel& model, double InitialRate, double horizon, unsigned int steps);
+
+        // Shift each level so the tree reprices the curve's discount factors exactly
+        void fitToCurve(const YieldCurve& curve);
+
+        // Price of a zero-coupon bond paying 1 at maturity
+        double priceZeroCouponBond(double maturity) const;
+
+        // Price of a straight bond
+        double priceBond(const Bond& bond) const;
+
+        // Price of a bond the issuer may redeem at callPrice on any of callDates
+        double priceCallableBond(const Bond& bond, const std::vector<double>& callDates, double callPrice) const;
+
+        // Price of a Bermudan swaption: on each exercise date the holder may enter a swap to
+        // swapEnd paying (payer) or receiving fixedRate, with fixed payments `frequency`
+        // times a year counted back from swapEnd. Exercise dates should be payment dates
+        double priceBermudanSwaption(const std::vector<double>& exerciseDates, double swapEnd, double fixedRate,
+                                     double frequency, double notional, bool isPayer) const;
+
+        unsigned int steps() const { return Steps; }
+        double timeStep() const { return TimeStep; }
+        std::size_t nodeCount() const { return Rates.size(); }
+};
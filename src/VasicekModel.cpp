@@ -1,4 +1,5 @@
 #include "VasicekModel.hpp"
+#include "Instrumentation.hpp"
 #include <iostream>
 #include <vector>
 #include <fstream>
@@ -15,6 +16,6 @@ double VasicekModel::simulateNextRate(double currentRate, double timeStep){
     double dw = distribution(generator);
 
     // Calculate next rate using Vasicek model
-    return currentRate + MeanReversion * (LongTermMean - currentRate) * timeStep 
-            + Volatility * std::sqrt(timeStep) * dw;
-}
\ No newline at end of file
+    IR_COUNT(Steps, 1);
+    return step(currentRate, MeanReversion, LongTermMean, Volatility, timeStep, dw);
+}
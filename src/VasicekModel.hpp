@@ -12,5 +12,38 @@ class VasicekModel : public InterestRateModel{
 
         // Simulate next interest rate using Vasicek model
         double simulateNextRate(double currentRate, double timeStep);
-};
 
+        // Advance a rate given the normal draw (time-homogeneous, so time is unused)
+        double nextRate(double currentRate, double, double timeStep, double dw) const{
+            return step(currentRate, MeanReversion, LongTermMean, Volatility, timeStep, dw);
+        }
+
+        // Affine zero-coupon bond price P = A exp(-B r) for a bond with tau years left,
+        // templated on the scalar type so Dual parameters give exact Jacobians
+        template<typename T>
+        static T zeroCouponBond(const T& meanRev, const T& ltm, const T& vol, double rate, double tau){
+            using std::exp;
+            T B = (1.0 - exp(-meanRev * tau)) / meanRev;
+            T logA = (B - tau) * (meanRev * meanRev * ltm - 0.5 * vol * vol) / (meanRev * meanRev)
+                        - vol * vol * B * B / (4.0 * meanRev);
+            return exp(logA - B * rate);
+        }
+
+        double zeroCouponBondPrice(double rate, double time, double maturity) const{
+            return zeroCouponBond(MeanReversion, LongTermMean, Volatility, rate, maturity - time);
+        }
+
+        std::unique_ptr<InterestRateModel> clone() const{
+            return std::make_unique<VasicekModel>(*this);
+        }
+
+        // Advance a rate by one step given a standard normal draw dw, templated on
+        // the scalar type so parameters can carry tangents for pathwise Greeks; with
+        // T = S = float the whole step runs in single precision
+        template<typename T, typename S = double>
+        static T step(const T& currentRate, const T& meanRev, const T& ltm, const T& vol,
+                      S timeStep, S dw){
+            return currentRate + meanRev * (ltm - currentRate) * timeStep
+                    + vol * std::sqrt(timeStep) * dw;
+        }
+};
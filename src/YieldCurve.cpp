@@ -0,0 +1,217 @@
+#include "YieldCurve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Constructor for YieldCurve class
+YieldCurve::YieldCurve(const std::vector<double>& times, const std::vector<double>& discountFactors,
+                        Interpolation method) : Method(method) {
+    if (times.size() != discountFactors.size() || times.empty()){
+        std::cerr << "Yield curve needs one discount factor per node time." << std::endl;
+        return;
+    }
+
+    // Anchor the curve at t = 0
+    Times.push_back(0.0);
+    LogDiscounts.push_back(0.0);
+    for (std::size_t i = 0; i < times.size(); ++i){
+        if (times[i] <= Times.back() || discountFactors[i] <= 0){
+            std::cerr << "Yield curve nodes must be increasing with positive discount factors." << std::endl;
+            Times.resize(1);
+            LogDiscounts.resize(1);
+            return;
+        }
+        Times.push_back(times[i]);
+        LogDiscounts.push_back(std::log(discountFactors[i]));
+    }
+    buildSegments();
+}
+
+// Precompute the interpolation coefficients of every segment
+void YieldCurve::buildSegments(){
+    std::size_t n = Times.size() - 1;
+    Segments.resize(n);
+    for (std::size_t i = 1; i <= n; ++i){
+        Segment& s = Segments[i - 1];
+        s.Start = Times[i - 1];
+        s.Length = Times[i] - Times[i - 1];
+        s.LogDiscountStart = LogDiscounts[i - 1];
+        s.Forward = -(LogDiscounts[i] - LogDiscounts[i - 1]) / s.Length;
+        s.G0 = s.G1 = s.Eta = s.A = 0.0;
+        s.Region = 0;
+    }
+    if (Method != Interpolation::MonotoneConvex || n == 0){
+        return;
+    }
+
+    // Instantaneous forwards at the nodes (Hagan-West), collared to keep them positive
+    std::vector<double> f(n + 1);
+    for (std::size_t i = 1; i < n; ++i){
+        double left = Segments[i - 1].Forward;
+        double right = Segments[i].Forward;
+        double wLeft = Segments[i].Length / (Segments[i - 1].Length + Segments[i].Length);
+        f[i] = wLeft * left + (1.0 - wLeft) * right;
+        if (left > 0 && right > 0){
+            f[i] = std::max(0.0, std::min(f[i], 2.0 * std::min(left, right)));
+        }
+    }
+    if (n == 1){
+        f[0] = f[1] = Segments[0].Forward;
+    } else {
+        f[0] = Segments[0].Forward - 0.5 * (f[1] - Segments[0].Forward);
+        f[n] = Segments[n - 1].Forward - 0.5 * (f[n - 1] - Segments[n - 1].Forward);
+        if (Segments[0].Forward > 0) f[0] = std::max(0.0, std::min(f[0], 2.0 * Segments[0].Forward));
+        if (Segments[n - 1].Forward > 0) f[n] = std::max(0.0, std::min(f[n], 2.0 * Segments[n - 1].Forward));
+    }
+
+    // Classify each segment into the four shapes of the monotone convex method
+    for (std::size_t i = 0; i < n; ++i){
+        Segment& s = Segments[i];
+        double g0 = f[i] - s.Forward;
+        double g1 = f[i + 1] - s.Forward;
+        s.G0 = g0;
+        s.G1 = g1;
+
+        if (g0 == 0.0 && g1 == 0.0){
+            s.Region = 0;
+        } else if ((g0 < 0 && -0.5 * g0 <= g1 && g1 <= -2.0 * g0) ||
+                   (g0 > 0 && -0.5 * g0 >= g1 && g1 >= -2.0 * g0)){
+            s.Region = 1;
+        } else if ((g0 < 0 && g1 > -2.0 * g0) || (g0 > 0 && g1 < -2.0 * g0)){
+            s.Region = 2;
+            s.Eta = (g1 + 2.0 * g0) / (g1 - g0);
+        } else if ((g0 > 0 && 0 > g1 && g1 > -0.5 * g0) || (g0 < 0 && 0 < g1 && g1 < -0.5 * g0)){
+            s.Region = 3;
+            s.Eta = 3.0 * g1 / (g1 - g0);
+        } else {
+            s.Region = 4;
+            s.Eta = g1 / (g1 + g0);
+            s.A = -g0 * g1 / (g0 + g1);
+        }
+    }
+}
+
+// Segment containing t; times past the last node use the last segment
+std::size_t YieldCurve::findSegment(double t) const{
+    std::size_t i = std::upper_bound(Times.begin(), Times.end(), t) - Times.begin();
+    if (i == 0) return 0;
+    return std::min(i - 1, Segments.size() - 1);
+}
+
+// log P(0, t) inside (or beyond) a segment
+double YieldCurve::logDiscount(std::size_t segment, double t) const{
+    const Segment& s = Segments[segment];
+    double x = (t - s.Start) / s.Length;
+
+    // Flat forward extrapolation past the last node
+    if (x > 1.0){
+        double end = s.LogDiscountStart - s.Length * s.Forward;
+        return end - (t - s.Start - s.Length) * forward(segment, s.Start + s.Length);
+    }
+
+    // Integral of the correction g over [0, x]; it integrates to zero over the segment
+    double G = 0.0;
+    double g0 = s.G0, g1 = s.G1, eta = s.Eta;
+    switch (s.Region){
+        case 1:
+            G = g0 * (x - 2.0 * x * x + x * x * x) + g1 * (x * x * x - x * x);
+            break;
+        case 2:
+            G = g0 * x;
+            if (x > eta) G += (g1 - g0) * std::pow(x - eta, 3) / (3.0 * (1.0 - eta) * (1.0 - eta));
+            break;
+        case 3:
+            G = g1 * x + (g0 - g1) * eta / 3.0 * (1.0 - (x < eta ? std::pow((eta - x) / eta, 3) : 0.0));
+            break;
+        case 4:
+            G = s.A * x + (g0 - s.A) * eta / 3.0 * (1.0 - (x < eta ? std::pow((eta - x) / eta, 3) : 0.0));
+            if (x > eta) G += (g1 - s.A) * std::pow(x - eta, 3) / (3.0 * (1.0 - eta) * (1.0 - eta));
+            break;
+        default:
+            break;
+    }
+    return s.LogDiscountStart - s.Length * (s.Forward * x + G);
+}
+
+// Instantaneous forward inside a segment
+double YieldCurve::forward(std::size_t segment, double t) const{
+    const Segment& s = Segments[segment];
+    double x = std::min(std::max((t - s.Start) / s.Length, 0.0), 1.0);
+    double g0 = s.G0, g1 = s.G1, eta = s.Eta;
+    double g = 0.0;
+    switch (s.Region){
+        case 1:
+            g = g0 * (1.0 - 4.0 * x + 3.0 * x * x) + g1 * (3.0 * x * x - 2.0 * x);
+            break;
+        case 2:
+            g = x <= eta ? g0 : g0 + (g1 - g0) * std::pow((x - eta) / (1.0 - eta), 2);
+            break;
+        case 3:
+            g = x < eta ? g1 + (g0 - g1) * std::pow((eta - x) / eta, 2) : g1;
+            break;
+        case 4:
+            g = x <= eta ? s.A + (g0 - s.A) * std::pow((eta - x) / eta, 2)
+                         : s.A + (g1 - s.A) * std::pow((x - eta) / (1.0 - eta), 2);
+            break;
+        default:
+            break;
+    }
+    return s.Forward + g;
+}
+
+// Discount factor P(0, t), memoized per query time
+double YieldCurve::discountFactor(double t) const{
+    if (Segments.empty() || t <= 0){
+        return 1.0;
+    }
+    auto it = Cache.find(t);
+    if (it != Cache.end()){
+        return it->second;
+    }
+    double df = std::exp(logDiscount(findSegment(t), t));
+    Cache.emplace(t, df);
+    return df;
+}
+
+// Discount factors for many times at once
+std::vector<double> YieldCurve::discountFactors(const std::vector<double>& times) const{
+    std::vector<double> dfs(times.size(), 1.0);
+    if (Segments.empty()){
+        return dfs;
+    }
+
+    std::size_t segment = 0;
+    double previous = -1.0;
+    for (std::size_t k = 0; k < times.size(); ++k){
+        double t = times[k];
+        if (t <= 0){
+            continue;
+        }
+        // Walk forward for sorted input, search again otherwise
+        if (t >= previous){
+            while (segment + 1 < Segments.size() && t > Times[segment + 1]) ++segment;
+        } else {
+            segment = findSegment(t);
+        }
+        previous = t;
+        dfs[k] = std::exp(logDiscount(segment, t));
+    }
+    return dfs;
+}
+
+// Continuously compounded zero rate
+double YieldCurve::zeroRate(double t) const{
+    if (t <= 0){
+        return forwardRate(0.0);
+    }
+    return -std::log(discountFactor(t)) / t;
+}
+
+// Instantaneous forward rate
+double YieldCurve::forwardRate(double t) const{
+    if (Segments.empty()){
+        return 0.0;
+    }
+    std::size_t segment = findSegment(t);
+    return forward(segment, std::min(t, Segments[segment].Start + Segments[segment].Length));
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+// Interpolation schemes for the discount curve
+enum class Interpolation{
+    LogLinear,      // piecewise flat forwards
+    MonotoneConvex  // Hagan-West: continuous, positivity-preserving forwards
+};
+
+// Class for a zero curve given by discount factors at node times. Per-segment
+// interpolation coefficients are computed once at construction and single-time queries
+// are memoized, so repeated lookups from portfolio pricing cost one hash probe
+class YieldCurve{
+    private:
+        // Precomputed shape of one segment (t[i-1], t[i]]
+        struct Segment{
+            double Start;
+            double Length;
+            double LogDiscountStart;
+            double Forward;     // discrete forward over the segment
+            double G0;          // monotone convex: node forward minus discrete forward, left end
+            double G1;          // ... and right end
+            double Eta;
+            double A;
+            int Region;
+        };
+
+        std::vector<double> Times;
+        std::vector<double> LogDiscounts;
+        Interpolation Method;
+        std::vector<Segment> Segments;
+        mutable std::unordered_map<double, double> Cache;
+
+        void buildSegments();
+        std::size_t findSegment(double t) const;
+        double logDiscount(std::size_t segment, double t) const;
+        double forward(std::size_t segment, double t) const;
+
+    public:
+        // Constructor for YieldCurve class; times must be increasing and positive, the
+        // curve is anchored at P(0) = 1
+        YieldCurve(const std::vector<double>& times, const std::vector<double>& discountFactors,
+                    Interpolation method = Interpolation::LogLinear);
+
+        // Discount factor P(0, t); memoized, so not safe to call concurrently on one object
+        double discountFactor(double t) const;
+
+        // Discount factors for many times at once. Sorted input is walked in a single pass.
+        // Bypasses the memo cache and is safe to call concurrently
+        std::vector<double> discountFactors(const std::vector<double>& times) const;
+
+        // Continuously compounded zero rate
+        double zeroRate(double t) const;
+
+        // Instantaneous forward rate f(0, t)
+        double forwardRate(double t) const;
+
+        const std::vector<double>& nodeTimes() const { return Times; }
+        Interpolation interpolation() const { return Method; }
+};
@@ -1,48 +1,26 @@
 
 #include <iostream>
+#include <string>
 #include <vector>
-#include <fstream>
 #include "VasicekModel.hpp"
 #include "CIRModel.hpp"
 #include "Bond.hpp"
 #include "RateSimulator.hpp"
 #include "Swaption.hpp"
-
-// Function to save simulation results to a CSV file
-void saveSimRes(const std::vector<double>& VasicekRates, const std::vector<double> CIRRates,
-				const std::string& filename){
-	// Open the output file and check opening is successful
-	std::ofstream outputFile(filename);
-	if (!outputFile.is_open()){
-		std::cerr << "Failed to open file: " << filename << std::endl;
-		return;
-	}
-
-	// Write header
-	outputFile << "Step, Vasicek Rate, CIR Rate\n";
-
-	// Write data
-	for (size_t i = 0; i < VasicekRates.size(); ++i){
-		outputFile << i << "," << VasicekRates[i] << "," << CIRRates[i] << "\n";
+#include "PathStore.hpp"
+#include "Instrumentation.hpp"
+#include "TraceRecorder.hpp"
+#include "CsvExporter.hpp"
+
+int main(int argc, char** argv){
+
+	// Pass --trace FILE to record a Chrome trace of the run
+	std::string traceFile;
+	if (argc > 2 && std::string(argv[1]) == "--trace"){
+		traceFile = argv[2];
+		TraceRecorder::start();
 	}
 
-	// Debug output to verify data writing
-    std::cout << "Wrote " << VasicekRates.size() << " lines to " << filename << std::endl;
-
-    // Close the file
-    outputFile.close();
-
-	// Check output was written successfully
-    if (outputFile.fail()) {
-        std::cerr << "Failed to properly write the file: " << filename << std::endl;
-    } else {
-        std::cout << "Successfully wrote the file: " << filename << std::endl;
-    }
-	
-}
-
-int main(){
-
 	// Create models, bond, swaption and rate simulator
 	VasicekModel vasicek(0.1,0.05,0.01);
 	CIRModel cir(0.1,0.05,0.01);
@@ -79,6 +57,31 @@ int main(){
 
 
 	// Save the simulation results to a CSV
-	saveSimRes(VasicekRates, CIRRates, "data/output.csv");
-}
+	CsvExporter exporter;
+	exporter.setIndexColumns(false, true, false);
+	exporter.addSeries("Vasicek Rate", VasicekRates.data(), 1, steps);
+	exporter.addSeries("CIR Rate", CIRRates.data(), 1, steps);
+	if (exporter.write("data/output.csv")){
+		std::cout << "Successfully wrote the file: data/output.csv" << std::endl;
+	}
+
+	// Save a full set of scenario paths in binary form for downstream jobs; CsvExporter
+	// can turn any path range of these files into CSV when needed
+	unsigned int numPaths = 10000;
+	unsigned int seed = 42;
+	if (PathStore::write<double>("data/vasicek_paths.bin", vasicek, "Vasicek", initialRate, timeStep, steps, numPaths, seed)
+		&& PathStore::write<double>("data/cir_paths.bin", cir, "CIR", initialRate, timeStep, steps, numPaths, seed)){
+		std::cout << "Wrote " << numPaths << " paths per model to data/vasicek_paths.bin and data/cir_paths.bin" << std::endl;
+	}
+
+	if (!traceFile.empty()){
+		TraceRecorder::stop();
+		if (TraceRecorder::write(traceFile)){
+			std::cout << "Wrote " << TraceRecorder::eventCount() << " trace events to " << traceFile << std::endl;
+		}
+	}
 
+#ifdef IRMODELING_INSTRUMENT
+	Instrumentation::report(std::cout);
+#endif
+}
@@ -0,0 +1,70 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "ScratchArena.hpp"
+#include "ScenarioEngine.hpp"
+#include "VasicekModel.hpp"
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("Arena buffers are aligned and reused after a scope ends", "[ScratchArena]") {
+    ScratchArena arena(1 << 16);
+    double* first;
+    {
+        ArenaScope scope(arena);
+        first = arena.allocate<double>(100);
+        float* second = arena.allocate<float>(3);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(first) % 64 == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+        REQUIRE(reinterpret_cast<char*>(second) >= reinterpret_cast<char*>(first + 100));
+        for (int i = 0; i < 100; ++i) first[i] = i;
+        REQUIRE(arena.used() > 0);
+    }
+    REQUIRE(arena.used() == 0);
+
+    ArenaScope scope(arena);
+    REQUIRE(arena.allocate<double>(100) == first);
+}
+
+TEST_CASE("Overflow chunks are merged on reset", "[ScratchArena]") {
+    ScratchArena arena(4096);
+    std::vector<double*> blocks;
+    for (int i = 0; i < 10; ++i){
+        double* block = arena.allocate<double>(1000);
+        block[999] = i;
+        blocks.push_back(block);
+    }
+    for (int i = 0; i < 10; ++i) REQUIRE(blocks[i][999] == i);
+    REQUIRE(arena.chunks() > 1);
+    std::size_t needed = arena.used();
+
+    arena.reset();
+    REQUIRE(arena.chunks() == 1);
+    REQUIRE(arena.capacity() >= needed);
+    for (int i = 0; i < 10; ++i) arena.allocate<double>(1000);
+    REQUIRE(arena.chunks() == 1);
+}
+
+TEST_CASE("Huge page arenas are 2 MB aligned and usable", "[ScratchArena]") {
+    ScratchArena arena(1 << 20, true);
+    REQUIRE(arena.hugePages());
+    REQUIRE(arena.capacity() % ScratchArena::HugePageSize == 0);
+
+    double* block = arena.allocate<double>(1 << 17);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(block) % ScratchArena::HugePageSize == 0);
+    for (int i = 0; i < (1 << 17); ++i) block[i] = i;
+    REQUIRE(block[(1 << 17) - 1] == (1 << 17) - 1);
+}
+
+TEST_CASE("Engines give the same prices on repeated runs from their arenas", "[ScratchArena]") {
+    VasicekModel model(0.3, 0.05, 0.01);
+    ScenarioEngine engine(500, 0.05, 120, 9, 2, 64);
+    std::vector<Scenario> scenarios(1);
+    std::vector<Bond> bonds = {Bond(1000, 5, 0.05, 0.5)};
+
+    double first = engine.run(model, 0.03, scenarios, bonds, {})[0].BondPrices[0];
+    REQUIRE(engine.run(model, 0.03, scenarios, bonds, {})[0].BondPrices[0] == first);
+
+    engine.setHugePages(true);
+    REQUIRE(engine.run(model, 0.03, scenarios, bonds, {})[0].BondPrices[0] == first);
+}
@@ -0,0 +1,115 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "Bond.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "RateSimulator.hpp"
+#include "ModelCalibrator.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Monte Carlo estimate of E[exp(-integral of r)] to check the affine formulas
+double monteCarloZeroCoupon(const InterestRateModel& model, double initialRate, double maturity) {
+    RateSimulator simulator;
+    double timeStep = 0.01;
+    unsigned int steps = static_cast<unsigned int>(maturity / timeStep + 0.5);
+    unsigned int numPaths = 4000;
+    std::vector<double> normals = simulator.generateNormals(numPaths, steps, 5);
+    std::vector<double> paths = simulator.simulatePathBlock(model, initialRate, timeStep, steps, normals);
+
+    double sum = 0.0;
+    for (unsigned int p = 0; p < numPaths; ++p) {
+        // Trapezoidal integral including the initial rate
+        double integral = 0.5 * initialRate;
+        for (unsigned int i = 0; i + 1 < steps; ++i) {
+            integral += paths[p * steps + i];
+        }
+        integral += 0.5 * paths[p * steps + steps - 1];
+        sum += std::exp(-integral * timeStep);
+    }
+    return sum / numPaths;
+}
+
+TEST_CASE("Affine zero-coupon bond formulas", "[ModelCalibrator]") {
+    VasicekModel vasicek(0.3, 0.05, 0.02);
+    CIRModel cir(0.3, 0.05, 0.1);
+
+    REQUIRE(vasicek.zeroCouponBondPrice(0.03, 2.0, 2.0) == Approx(1.0));
+    REQUIRE(cir.zeroCouponBondPrice(0.03, 2.0, 2.0) == Approx(1.0));
+
+    REQUIRE(vasicek.zeroCouponBondPrice(0.03, 0.0, 5.0) == Approx(monteCarloZeroCoupon(vasicek, 0.03, 5.0)).epsilon(0.005));
+    REQUIRE(cir.zeroCouponBondPrice(0.03, 0.0, 5.0) == Approx(monteCarloZeroCoupon(cir, 0.03, 5.0)).epsilon(0.005));
+}
+
+TEST_CASE("Vasicek calibration recovers parameters from zero rates", "[ModelCalibrator]") {
+    double initialRate = 0.02;
+    VasicekModel truth(0.25, 0.06, 0.015);
+
+    ModelCalibrator calibrator;
+    for (double T : {0.25, 0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0, 15.0, 20.0, 30.0}) {
+        calibrator.addZeroRate(T, -std::log(truth.zeroCouponBondPrice(initialRate, 0.0, T)) / T);
+    }
+
+    VasicekModel model(0.1, 0.05, 0.01);
+    CalibrationResult result = calibrator.calibrate(model, initialRate);
+
+    REQUIRE(result.Converged);
+    REQUIRE(result.RMSE < 1e-8);
+    REQUIRE(model.getMeanReversion() == Approx(0.25).epsilon(1e-4));
+    REQUIRE(model.getLongTermMean() == Approx(0.06).epsilon(1e-4));
+    REQUIRE(model.getVolatility() == Approx(0.015).epsilon(1e-3));
+}
+
+TEST_CASE("CIR calibration to bond prices, multithreaded and warm-started", "[ModelCalibrator]") {
+    double initialRate = 0.03;
+    CIRModel truth(0.4, 0.05, 0.12);
+
+    // Many bonds so the rows are split across threads
+    std::vector<Bond> bonds;
+    std::vector<double> prices;
+    for (int i = 1; i <= 200; ++i) {
+        Bond bond(100, 0.25 * i, 0.04, 0.5);
+        double price = 0.0;
+        for (const CashFlow& cf : bond.cashFlows()) {
+            price += cf.Amount * truth.zeroCouponBondPrice(initialRate, 0.0, cf.Time);
+        }
+        bonds.push_back(bond);
+        prices.push_back(price);
+    }
+
+    ModelCalibrator serial(1);
+    ModelCalibrator parallel(4);
+    for (std::size_t i = 0; i < bonds.size(); ++i) {
+        serial.addBondPrice(bonds[i], prices[i]);
+        parallel.addBondPrice(bonds[i], prices[i]);
+    }
+
+    CIRModel a(0.2, 0.04, 0.05);
+    CIRModel b(0.2, 0.04, 0.05);
+    CalibrationResult cold = serial.calibrate(a, initialRate);
+    CalibrationResult threaded = parallel.calibrate(b, initialRate);
+
+    // A curve alone pins CIR down only loosely, so check the fit rather than the parameters
+    REQUIRE(cold.Converged);
+    REQUIRE(cold.RMSE < 1e-4);
+    REQUIRE(a.getLongTermMean() == Approx(0.05).epsilon(0.05));
+    REQUIRE(threaded.MeanReversion == Approx(cold.MeanReversion).epsilon(1e-10));
+    REQUIRE(threaded.LongTermMean == Approx(cold.LongTermMean).epsilon(1e-10));
+
+    // Recalibrate to a slightly moved curve starting from the previous fit
+    serial.clearQuotes();
+    CIRModel moved(0.41, 0.051, 0.12);
+    for (const Bond& bond : bonds) {
+        double price = 0.0;
+        for (const CashFlow& cf : bond.cashFlows()) {
+            price += cf.Amount * moved.zeroCouponBondPrice(initialRate, 0.0, cf.Time);
+        }
+        serial.addBondPrice(bond, price);
+    }
+    CalibrationResult warm = serial.calibrate(a, initialRate);
+
+    REQUIRE(warm.Converged);
+    REQUIRE(warm.RMSE < 1e-4);
+    REQUIRE(warm.Iterations <= cold.Iterations);
+}
@@ -0,0 +1,105 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "CompressedPathBlock.hpp"
+#include "PathStore.hpp"
+#include "RateSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "Bond.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+TEST_CASE("Compressed paths decode within the declared tolerance", "[CompressedPathBlock]") {
+    VasicekModel model(0.3, 0.05, 0.01);
+    RateSimulator simulator;
+    unsigned int numPaths = 500;
+    unsigned int steps = 365;   // not a multiple of the frame size
+    double tolerance = 1e-6;
+
+    std::vector<double> normals = simulator.generateNormals(numPaths, steps, 17);
+    std::vector<double> paths = simulator.simulatePathBlock(model, 0.03, 1.0 / 365, steps, normals);
+    CompressedPathBlock block = CompressedPathBlock::encode(paths.data(), numPaths, steps, tolerance);
+
+    REQUIRE(block.numPaths() == numPaths);
+    REQUIRE(block.steps() == steps);
+    REQUIRE(block.tolerance() == tolerance);
+
+    // Smooth daily paths at 0.01bp need under a fifth of the raw size
+    double ratio = static_cast<double>(paths.size() * sizeof(double)) / block.size();
+    INFO("compression ratio " << ratio);
+    REQUIRE(ratio > 5.0);
+
+    std::vector<double> decoded(paths.size());
+    block.decodeAll(decoded.data());
+    double maxError = 0.0;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        maxError = std::max(maxError, std::fabs(decoded[i] - paths[i]));
+    }
+    REQUIRE(maxError <= tolerance * (1.0 + 1e-9));
+
+    // Random access to a single path gives the same values
+    std::vector<float> single(steps);
+    block.decode(123, single.data());
+    for (unsigned int i = 0; i < steps; ++i) {
+        REQUIRE(single[i] == static_cast<float>(decoded[123 * steps + i]));
+    }
+}
+
+TEST_CASE("Compression handles jumps, negative rates and flat paths", "[CompressedPathBlock]") {
+    std::vector<double> paths = {0.05, 0.05, 0.05, 0.05, -0.02, 0.4, -0.3, 0.0};
+    CompressedPathBlock block = CompressedPathBlock::encode(paths.data(), 2, 4, 1e-9);
+    std::vector<double> decoded(paths.size());
+    block.decodeAll(decoded.data());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        REQUIRE(decoded[i] == Approx(paths[i]).margin(1e-9));
+    }
+
+    // A view of the encoded bytes decodes the same way
+    CompressedPathBlock view = CompressedPathBlock::view(block.data(), block.size());
+    std::vector<double> viewed(paths.size());
+    view.decodeAll(viewed.data());
+    REQUIRE(viewed == decoded);
+}
+
+TEST_CASE("Compressed path files price like the raw paths", "[CompressedPathBlock]") {
+    CIRModel model(0.3, 0.05, 0.05);
+    unsigned int numPaths = 600;
+    unsigned int steps = 200;
+    double timeStep = 0.05;
+    double tolerance = 1e-6;
+
+    REQUIRE(PathStore::write<double>("test_paths_raw.bin", model, "CIR", 0.03, timeStep, steps, numPaths, 5, 256));
+    REQUIRE(PathStore::write<double>("test_paths_packed.bin", model, "CIR", 0.03, timeStep, steps, numPaths, 5, 256,
+                                     PathLayout::PathMajor, tolerance));
+
+    PathStore raw;
+    PathStore packed;
+    REQUIRE(raw.open("test_paths_raw.bin"));
+    REQUIRE(packed.open("test_paths_packed.bin"));
+    REQUIRE_FALSE(raw.compressed());
+    REQUIRE(packed.compressed());
+    REQUIRE(packed.block<double>(0) == nullptr);
+
+    Bond bond(100, 10, 0.05, 0.5);
+    std::vector<CashFlow> schedule = bond.cashFlowSchedule(timeStep, steps);
+    std::vector<double> decoded(static_cast<std::size_t>(256) * steps);
+    double rawSum = 0.0;
+    double packedSum = 0.0;
+    for (std::size_t b = 0; b < raw.numBlocks(); ++b) {
+        const double* rates = raw.block<double>(b);
+        packed.compressedBlock(b).decodeAll(decoded.data());
+        for (std::size_t p = 0; p < raw.blockSize(b); ++p) {
+            rawSum += Bond::price(rates + p * steps, schedule);
+            packedSum += Bond::price(decoded.data() + p * steps, schedule);
+        }
+    }
+    REQUIRE(packedSum == Approx(rawSum).epsilon(1e-5));
+    REQUIRE(packed.rate<double>(300, 150) == Approx(raw.rate<double>(300, 150)).margin(tolerance));
+
+    raw.close();
+    packed.close();
+    std::remove("test_paths_raw.bin");
+    std::remove("test_paths_packed.bin");
+}
@@ -0,0 +1,102 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "COSEngine.hpp"
+#include "CrankNicolsonSolver.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Closed-form Vasicek option on a zero-coupon bond
+double vasicekBondOption(const VasicekModel& model, double r0, double expiry, double maturity, double strike, bool isCall) {
+    double a = model.getMeanReversion();
+    double s = model.getVolatility();
+    double pT = model.zeroCouponBondPrice(r0, 0.0, expiry);
+    double pS = model.zeroCouponBondPrice(r0, 0.0, maturity);
+    double sigmaP = s / a * (1.0 - std::exp(-a * (maturity - expiry))) * std::sqrt((1.0 - std::exp(-2.0 * a * expiry)) / (2.0 * a));
+    double h = std::log(pS / (pT * strike)) / sigmaP + 0.5 * sigmaP;
+    auto N = [](double x) { return 0.5 * std::erfc(-x * std::sqrt(0.5)); };
+    if (isCall) {
+        return pS * N(h) - strike * pT * N(h - sigmaP);
+    }
+    return strike * pT * N(sigmaP - h) - pS * N(-h);
+}
+
+TEST_CASE("COS Vasicek bond options match the closed form across strikes", "[COSEngine]") {
+    VasicekModel model(0.3, 0.04, 0.015);
+    double r0 = 0.03;
+    COSEngine engine;
+
+    std::vector<double> strikes;
+    for (double K = 0.90; K <= 1.0; K += 0.01) {
+        strikes.push_back(K);
+    }
+    std::vector<double> calls = engine.zeroCouponBondOptions(model, r0, 1.0, 3.0, strikes, true);
+    std::vector<double> puts = engine.zeroCouponBondOptions(model, r0, 1.0, 3.0, strikes, false);
+    for (std::size_t s = 0; s < strikes.size(); ++s) {
+        REQUIRE(calls[s] == Approx(vasicekBondOption(model, r0, 1.0, 3.0, strikes[s], true)).margin(1e-9));
+        REQUIRE(puts[s] == Approx(vasicekBondOption(model, r0, 1.0, 3.0, strikes[s], false)).margin(1e-9));
+    }
+}
+
+TEST_CASE("COS CIR bond options reprice the bond and satisfy parity", "[COSEngine]") {
+    CIRModel model(0.3, 0.04, 0.08);
+    double r0 = 0.03;
+    COSEngine engine;
+
+    double pT = model.zeroCouponBondPrice(r0, 0.0, 2.0);
+    double pS = model.zeroCouponBondPrice(r0, 0.0, 5.0);
+    std::vector<double> strikes = {0.0, 0.85, 0.9, 0.95};
+    std::vector<double> calls = engine.zeroCouponBondOptions(model, r0, 2.0, 5.0, strikes, true);
+    std::vector<double> puts = engine.zeroCouponBondOptions(model, r0, 2.0, 5.0, strikes, false);
+
+    // A zero strike call is the bond itself, which checks the discounted characteristic function
+    REQUIRE(calls[0] == Approx(pS).epsilon(1e-9));
+    for (std::size_t s = 1; s < strikes.size(); ++s) {
+        REQUIRE(calls[s] - puts[s] == Approx(pS - strikes[s] * pT).margin(1e-9));
+    }
+
+    // Fewer terms converge to the same prices
+    COSEngine coarse(128);
+    std::vector<double> coarseCalls = coarse.zeroCouponBondOptions(model, r0, 2.0, 5.0, strikes, true);
+    for (std::size_t s = 0; s < strikes.size(); ++s) {
+        REQUIRE(coarseCalls[s] == Approx(calls[s]).margin(1e-9));
+    }
+}
+
+TEST_CASE("COS CIR caplet matches the PDE solver", "[COSEngine]") {
+    CIRModel model(0.3, 0.04, 0.08);
+    double r0 = 0.03;
+
+    // A one-period payer swaption settled at expiry is a caplet on the same period
+    double strike = 0.035;
+    COSEngine engine;
+    std::vector<double> caps = engine.capFloors(model, r0, 2.0, 1.0, {strike}, 100.0, true);
+    CrankNicolsonSolver solver(401, 400);
+    std::vector<double> swaption = solver.priceSwaptions(model, r0, {Swaption(strike, 1.0, 100.0, 1.0)}, 1.0, true);
+    REQUIRE(caps[0] == Approx(swaption[0]).epsilon(1e-3));
+}
+
+TEST_CASE("COS cap minus floor is the forward swap", "[COSEngine]") {
+    VasicekModel model(0.3, 0.04, 0.015);
+    double r0 = 0.03;
+    double frequency = 4.0;
+    double delta = 1.0 / frequency;
+    COSEngine engine;
+
+    std::vector<double> strikes = {0.02, 0.03, 0.04, 0.05};
+    std::vector<double> caps = engine.capFloors(model, r0, 5.0, frequency, strikes, 1.0, true);
+    std::vector<double> floors = engine.capFloors(model, r0, 5.0, frequency, strikes, 1.0, false);
+    for (std::size_t s = 0; s < strikes.size(); ++s) {
+        double swap = 0.0;
+        for (int p = 1; p < 20; ++p) {
+            double start = model.zeroCouponBondPrice(r0, 0.0, p * delta);
+            double end = model.zeroCouponBondPrice(r0, 0.0, (p + 1) * delta);
+            swap += start - (1.0 + delta * strikes[s]) * end;
+        }
+        REQUIRE(caps[s] - floors[s] == Approx(swap).margin(1e-9));
+        REQUIRE(caps[s] > 0.0);
+        REQUIRE(floors[s] > 0.0);
+    }
+}
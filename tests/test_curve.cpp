@@ -0,0 +1,106 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "Bond.hpp"
+#include "YieldCurve.hpp"
+#include "CurveBootstrapper.hpp"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Log-linear interpolation", "[YieldCurve]") {
+    YieldCurve curve({1.0, 2.0, 5.0}, {0.97, 0.93, 0.80});
+
+    REQUIRE(curve.discountFactor(0.0) == 1.0);
+    REQUIRE(curve.discountFactor(2.0) == Approx(0.93).epsilon(1e-14));
+    REQUIRE(curve.discountFactor(5.0) == Approx(0.80).epsilon(1e-14));
+
+    // Geometric interpolation inside a segment, flat forward beyond the last node
+    REQUIRE(curve.discountFactor(1.5) == Approx(std::sqrt(0.97 * 0.93)).epsilon(1e-14));
+    double lastForward = -std::log(0.80 / 0.93) / 3.0;
+    REQUIRE(curve.forwardRate(3.0) == Approx(lastForward));
+    REQUIRE(curve.discountFactor(6.0) == Approx(0.80 * std::exp(-lastForward)).epsilon(1e-14));
+}
+
+TEST_CASE("Monotone convex forwards are continuous and positive", "[YieldCurve]") {
+    std::vector<double> times = {0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0, 30.0};
+    std::vector<double> zeros = {0.010, 0.012, 0.018, 0.022, 0.028, 0.030, 0.031, 0.027};
+    std::vector<double> dfs;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        dfs.push_back(std::exp(-zeros[i] * times[i]));
+    }
+    YieldCurve curve(times, dfs, Interpolation::MonotoneConvex);
+
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        REQUIRE(curve.discountFactor(times[i]) == Approx(dfs[i]).epsilon(1e-12));
+    }
+    for (std::size_t i = 0; i + 1 < times.size(); ++i) {
+        double left = curve.forwardRate(times[i] - 1e-9);
+        double right = curve.forwardRate(times[i] + 1e-9);
+        REQUIRE(left == Approx(right).margin(1e-6));
+    }
+    for (double t = 0.0; t < 30.0; t += 0.05) {
+        REQUIRE(curve.forwardRate(t) >= 0.0);
+    }
+}
+
+TEST_CASE("Batch and memoized queries agree", "[YieldCurve]") {
+    YieldCurve curve({0.25, 1.0, 2.0, 5.0, 10.0}, {0.995, 0.98, 0.955, 0.88, 0.76}, Interpolation::MonotoneConvex);
+
+    std::vector<double> sorted;
+    for (double t = 0.0; t <= 12.0; t += 0.1) {
+        sorted.push_back(t);
+    }
+    std::vector<double> unsorted = {7.3, 0.1, 11.0, 2.0, 0.0, 4.4};
+
+    std::vector<double> a = curve.discountFactors(sorted);
+    std::vector<double> b = curve.discountFactors(unsorted);
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        REQUIRE(a[i] == Approx(curve.discountFactor(sorted[i])).epsilon(1e-15));
+        REQUIRE(curve.discountFactor(sorted[i]) == a[i]);
+    }
+    for (std::size_t i = 0; i < unsorted.size(); ++i) {
+        REQUIRE(b[i] == Approx(curve.discountFactor(unsorted[i])).epsilon(1e-15));
+    }
+}
+
+TEST_CASE("Bootstrapped curves reprice their instruments", "[CurveBootstrapper]") {
+    Bond bond(100, 4, 0.04, 0.5);
+
+    CurveBootstrapper bootstrapper;
+    bootstrapper.addDeposit(0.25, 0.010);
+    bootstrapper.addDeposit(0.5, 0.012);
+    bootstrapper.addSwap(2, 0.018, 1);
+    bootstrapper.addBond(bond, 102.5);
+    bootstrapper.addSwap(7, 0.027, 1);
+    bootstrapper.addSwap(10, 0.030, 1);
+
+    for (Interpolation method : {Interpolation::LogLinear, Interpolation::MonotoneConvex}) {
+        YieldCurve curve = bootstrapper.bootstrap(method);
+
+        REQUIRE(curve.discountFactor(0.25) == Approx(1.0 / (1.0 + 0.010 * 0.25)).epsilon(1e-12));
+        REQUIRE(curve.discountFactor(0.5) == Approx(1.0 / (1.0 + 0.012 * 0.5)).epsilon(1e-12));
+        REQUIRE(bond.price(curve) == Approx(102.5).epsilon(1e-12));
+
+        for (int maturity : {2, 7, 10}) {
+            double parRate = maturity == 2 ? 0.018 : (maturity == 7 ? 0.027 : 0.030);
+            double annuity = 0.0;
+            for (int i = 1; i <= maturity; ++i) {
+                annuity += curve.discountFactor(i);
+            }
+            REQUIRE(parRate * annuity == Approx(1.0 - curve.discountFactor(maturity)).epsilon(1e-10));
+        }
+    }
+}
+
+TEST_CASE("Bond priced off a flat curve", "[YieldCurve]") {
+    double rate = 0.05;
+    std::vector<double> times = {1.0, 5.0, 10.0};
+    std::vector<double> dfs;
+    for (double t : times) {
+        dfs.push_back(std::exp(-rate * t));
+    }
+    YieldCurve curve(times, dfs);
+    Bond bond(1000, 10, 0.05, 0.5);
+
+    REQUIRE(bond.price(curve) == Approx(bond.price(std::vector<double>(500, rate), 0.05)).epsilon(1e-12));
+}
@@ -0,0 +1,118 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "CIRModel.hpp"
+#include "RateHistory.hpp"
+#include "ModelEstimator.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <vector>
+
+// Exact Vasicek transitions
+std::vector<double> vasicekHistory(double a, double b, double sigma, double r0, double timeStep, unsigned int n) {
+    std::default_random_engine generator(17);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    double decay = std::exp(-a * timeStep);
+    double sd = sigma * std::sqrt((1 - decay * decay) / (2 * a));
+
+    std::vector<double> rates(n);
+    double r = r0;
+    for (unsigned int i = 0; i < n; ++i) {
+        r = r * decay + b * (1 - decay) + sd * distribution(generator);
+        rates[i] = r;
+    }
+    return rates;
+}
+
+// CIR with fine Euler sub-steps between observations
+std::vector<double> cirHistory(double a, double b, double sigma, double r0, double timeStep, unsigned int n) {
+    CIRModel model(a, b, sigma);
+    std::default_random_engine generator(23);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    const int substeps = 20;
+
+    std::vector<double> rates(n);
+    double r = r0;
+    for (unsigned int i = 0; i < n; ++i) {
+        for (int k = 0; k < substeps; ++k) {
+            r = model.nextRate(r, 0.0, timeStep / substeps, distribution(generator));
+        }
+        rates[i] = r;
+    }
+    return rates;
+}
+
+TEST_CASE("Rate history parses names, values and gaps", "[RateHistory]") {
+    {
+        std::ofstream file("test_history_small.csv");
+        file << "date,USD,EUR\r\n";
+        file << "2020-01-01,0.015,-0.005\r\n";
+        file << "2020-01-02,,NA\r\n";
+        file << "2020-01-03,1.6e-2\r\n";
+        file << "2020-01-06,0.017,-0.004,extra\n";
+    }
+
+    RateHistory history;
+    REQUIRE(history.load("test_history_small.csv"));
+    REQUIRE(history.size() == 2);
+    REQUIRE(history.name(0) == "USD");
+    REQUIRE(history.name(1) == "EUR");
+
+    const std::vector<double>& usd = history.series(0);
+    const std::vector<double>& eur = history.series(1);
+    REQUIRE(usd.size() == 4);
+    REQUIRE(eur.size() == 4);
+    REQUIRE(usd[0] == 0.015);
+    REQUIRE(std::isnan(usd[1]));
+    REQUIRE(usd[2] == 0.016);
+    REQUIRE(usd[3] == 0.017);
+    REQUIRE(eur[0] == -0.005);
+    REQUIRE(std::isnan(eur[1]));
+    REQUIRE(std::isnan(eur[2]));
+    REQUIRE(eur[3] == -0.004);
+
+    REQUIRE_FALSE(history.load("does_not_exist.csv"));
+}
+
+TEST_CASE("Parallel estimation recovers Vasicek and CIR parameters", "[ModelEstimator]") {
+    double timeStep = 1.0 / 252;
+    unsigned int n = 20000;
+    std::vector<double> vasicek = vasicekHistory(1.5, 0.04, 0.02, 0.03, timeStep, n);
+    std::vector<double> cir = cirHistory(1.5, 0.05, 0.1, 0.03, timeStep, n);
+
+    {
+        std::ofstream file("test_history.csv");
+        file.precision(17);
+        file << "date,VAS,CIR\n";
+        for (unsigned int i = 0; i < n; ++i) {
+            file << i << "," << vasicek[i] << "," << cir[i] << "\n";
+        }
+    }
+
+    RateHistory history;
+    REQUIRE(history.load("test_history.csv"));
+    REQUIRE(history.series(0) == vasicek);
+
+    ModelEstimator estimator;
+    std::vector<SeriesEstimate> estimates = estimator.estimateAll(history, timeStep, 2);
+    REQUIRE(estimates.size() == 2);
+    REQUIRE(estimates[0].Name == "VAS");
+
+    // Mean reversion is only weakly identified from ~80 years of data, so its tolerance is wide
+    const EstimationResult& v = estimates[0].Vasicek;
+    REQUIRE(v.Converged);
+    REQUIRE(v.Observations == n - 1);
+    REQUIRE(v.MeanReversion == Approx(1.5).epsilon(0.3));
+    REQUIRE(v.LongTermMean == Approx(0.04).epsilon(0.1));
+    REQUIRE(v.Volatility == Approx(0.02).epsilon(0.03));
+
+    const EstimationResult& c = estimates[1].CIR;
+    REQUIRE(c.Converged);
+    REQUIRE(c.MeanReversion == Approx(1.5).epsilon(0.5));
+    REQUIRE(c.LongTermMean == Approx(0.05).epsilon(0.1));
+    REQUIRE(c.Volatility == Approx(0.1).epsilon(0.03));
+
+    // The exact CIR likelihood explains CIR data better than the Gaussian Vasicek fit
+    REQUIRE(c.LogLikelihood > estimates[1].Vasicek.LogLikelihood);
+}
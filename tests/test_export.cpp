@@ -0,0 +1,105 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "CsvExporter.hpp"
+#include "PathStore.hpp"
+#include "RateSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Read a CSV back as its header and rows of cells
+std::vector<std::vector<std::string>> readCsv(const std::string& filename) {
+    std::vector<std::vector<std::string>> rows;
+    std::ifstream in(filename);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::vector<std::string> cells;
+        std::stringstream stream(line);
+        std::string cell;
+        while (std::getline(stream, cell, ',')) {
+            cells.push_back(cell);
+        }
+        rows.push_back(cells);
+    }
+    return rows;
+}
+
+TEST_CASE("CSV export round-trips every rate exactly", "[CsvExporter]") {
+    VasicekModel vasicek(0.3, 0.05, 0.01);
+    CIRModel cir(0.3, 0.05, 0.05);
+    RateSimulator simulator;
+    unsigned int numPaths = 200;
+    unsigned int steps = 30;
+    std::vector<double> normals = simulator.generateNormals(numPaths, steps, 3);
+    std::vector<double> vasicekPaths = simulator.simulatePathBlock(vasicek, 0.03, 0.1, steps, normals);
+    std::vector<double> cirPaths = simulator.simulatePathBlock(cir, 0.03, 0.1, steps, normals);
+
+    // A small buffer forces many hand-overs to the writer thread
+    CsvExporter exporter(4096);
+    exporter.addSeries("Vasicek", vasicekPaths.data(), numPaths, steps);
+    exporter.addSeries("CIR", cirPaths.data(), numPaths, steps);
+    exporter.setIndexColumns(true, true, true, 0.1);
+    REQUIRE(exporter.write("test_export.csv"));
+
+    std::vector<std::vector<std::string>> rows = readCsv("test_export.csv");
+    REQUIRE(rows.size() == 1 + numPaths * steps);
+    REQUIRE(rows[0] == std::vector<std::string>{"Path", "Step", "Time", "Vasicek", "CIR"});
+    for (unsigned int p = 0; p < numPaths; ++p) {
+        for (unsigned int i = 0; i < steps; ++i) {
+            const std::vector<std::string>& row = rows[1 + p * steps + i];
+            REQUIRE(std::stoul(row[0]) == p);
+            REQUIRE(std::stoul(row[1]) == i);
+            REQUIRE(std::stod(row[2]) == Approx((i + 1) * 0.1));
+            REQUIRE(std::stod(row[3]) == vasicekPaths[p * steps + i]);
+            REQUIRE(std::stod(row[4]) == cirPaths[p * steps + i]);
+        }
+    }
+    std::remove("test_export.csv");
+}
+
+TEST_CASE("CSV export selects columns and path ranges from path files", "[CsvExporter]") {
+    CIRModel model(0.3, 0.05, 0.05);
+    RateSimulator simulator;
+    unsigned int numPaths = 100;
+    unsigned int steps = 20;
+    REQUIRE(PathStore::write<float>("test_export_paths.bin", model, "CIR", 0.03, 0.05, steps, numPaths, 9, 16, PathLayout::StepMajor));
+    std::vector<float> normals = simulator.generateNormals<float>(numPaths, steps, 9);
+    std::vector<float> paths = simulator.simulatePathBlock(model, 0.03, 0.05, steps, normals);
+
+    PathStore store;
+    REQUIRE(store.open("test_export_paths.bin"));
+    CsvExporter exporter;
+    exporter.addSeries("CIR", store);
+    exporter.addSeries("Copy", paths.data(), numPaths, steps);
+    exporter.setIndexColumns(true, false, false);
+    exporter.setPathRange(40, 45);
+    REQUIRE(exporter.write("test_export_range.csv"));
+
+    std::vector<std::vector<std::string>> rows = readCsv("test_export_range.csv");
+    REQUIRE(rows.size() == 1 + 5 * steps);
+    REQUIRE(rows[0] == std::vector<std::string>{"Path", "CIR", "Copy"});
+    for (unsigned int p = 40; p < 45; ++p) {
+        for (unsigned int i = 0; i < steps; ++i) {
+            const std::vector<std::string>& row = rows[1 + (p - 40) * steps + i];
+            REQUIRE(std::stoul(row[0]) == p);
+            REQUIRE(static_cast<float>(std::stod(row[1])) == paths[p * steps + i]);
+            REQUIRE(row[1] == row[2]);
+        }
+    }
+    store.close();
+    std::remove("test_export_paths.bin");
+    std::remove("test_export_range.csv");
+}
+
+TEST_CASE("CSV export rejects series of different shapes", "[CsvExporter]") {
+    std::vector<double> a(10, 0.01), b(12, 0.02);
+    CsvExporter exporter;
+    exporter.addSeries("A", a.data(), 1, 10);
+    exporter.addSeries("B", b.data(), 1, 12);
+    REQUIRE_FALSE(exporter.write("test_export_bad.csv"));
+}
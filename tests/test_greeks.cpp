@@ -0,0 +1,111 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "Dual.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "PathwiseGreeks.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Dual arithmetic against known derivatives
+TEST_CASE("Dual number derivatives", "[Dual]") {
+    Dual<2> x(0.7, 0);
+    Dual<2> y(1.3, 1);
+
+    Dual<2> f = exp(x * y) + log(y) / x - sqrt(x) * pow(y, 3.0);
+
+    double fx = y.Value * std::exp(x.Value * y.Value) - std::log(y.Value) / (x.Value * x.Value)
+                - 0.5 / std::sqrt(x.Value) * std::pow(y.Value, 3.0);
+    double fy = x.Value * std::exp(x.Value * y.Value) + 1.0 / (y.Value * x.Value)
+                - std::sqrt(x.Value) * 3.0 * std::pow(y.Value, 2.0);
+
+    REQUIRE(f.d(0) == Approx(fx).epsilon(1e-12));
+    REQUIRE(f.d(1) == Approx(fy).epsilon(1e-12));
+}
+
+// Duration of a bond priced off constant rates
+TEST_CASE("Bond price derivative with constant rates", "[Dual]") {
+    double rate = 0.04;
+    double timeStep = 0.05;
+    Bond bond(1000, 5, 0.05, 0.5);
+
+    std::vector<Dual<1>> rates(200, Dual<1>(rate, 0));
+    Dual<1> price = bond.price(rates, timeStep);
+
+    double expected = 0.0;
+    for (int i = 1; i <= 10; ++i) {
+        expected -= 1000 * 0.05 * 0.5 * i * 0.5 * std::exp(-rate * i * 0.5);
+    }
+    expected -= 1000 * 5 * std::exp(-rate * 5);
+
+    REQUIRE(price.Value == Approx(bond.price(std::vector<double>(200, rate), timeStep)));
+    REQUIRE(price.d(0) == Approx(expected).epsilon(1e-10));
+}
+
+// Pathwise Greeks agree with central finite differences on common random numbers
+TEST_CASE("Vasicek bond Greeks match bumped prices", "[PathwiseGreeks]") {
+    PathwiseGreeks greeks;
+    Bond bond(1000, 10, 0.05, 0.5);
+    double initialRate = 0.03;
+    double timeStep = 0.05;
+    unsigned int steps = 220;
+    unsigned int numPaths = 200;
+    unsigned int seed = 42;
+    double h = 1e-5;
+
+    VasicekModel model(0.1, 0.05, 0.01);
+    PathwiseSensitivities s = greeks.bondSensitivities(bond, model, initialRate, timeStep, steps, numPaths, seed);
+
+    auto bumped = [&](double r0, double a, double b, double sigma){
+        return greeks.bondSensitivities(bond, VasicekModel(a, b, sigma), r0, timeStep, steps, numPaths, seed).Price;
+    };
+
+    double fdRate = (bumped(initialRate + h, 0.1, 0.05, 0.01) - bumped(initialRate - h, 0.1, 0.05, 0.01)) / (2 * h);
+    double fdMeanRev = (bumped(initialRate, 0.1 + h, 0.05, 0.01) - bumped(initialRate, 0.1 - h, 0.05, 0.01)) / (2 * h);
+    double fdLtm = (bumped(initialRate, 0.1, 0.05 + h, 0.01) - bumped(initialRate, 0.1, 0.05 - h, 0.01)) / (2 * h);
+    double fdVol = (bumped(initialRate, 0.1, 0.05, 0.01 + h) - bumped(initialRate, 0.1, 0.05, 0.01 - h)) / (2 * h);
+
+    REQUIRE(s.InitialRate == Approx(fdRate).epsilon(1e-4));
+    REQUIRE(s.MeanReversion == Approx(fdMeanRev).epsilon(1e-4));
+    REQUIRE(s.LongTermMean == Approx(fdLtm).epsilon(1e-4));
+    REQUIRE(s.Volatility == Approx(fdVol).epsilon(1e-3));
+    REQUIRE(s.BlackVolatility == 0.0);
+
+    // Bonds lose value as rates rise
+    REQUIRE(s.InitialRate < 0);
+    REQUIRE(s.LongTermMean < 0);
+}
+
+TEST_CASE("CIR swaption Greeks match bumped prices", "[PathwiseGreeks]") {
+    PathwiseGreeks greeks;
+    Swaption swaption(0.05, 5, 1000, 1);
+    double initialRate = 0.03;
+    double timeStep = 0.05;
+    unsigned int steps = 200;
+    unsigned int numPaths = 200;
+    unsigned int seed = 7;
+    double h = 1e-5;
+
+    CIRModel model(0.1, 0.05, 0.01);
+    PathwiseSensitivities s = greeks.swaptionSensitivities(swaption, model, initialRate, 0.2, 4, true,
+                                                            timeStep, steps, numPaths, seed);
+
+    auto bumped = [&](double r0, double sigma, double blackVol){
+        return greeks.swaptionSensitivities(swaption, CIRModel(0.1, 0.05, sigma), r0, blackVol, 4, true,
+                                            timeStep, steps, numPaths, seed).Price;
+    };
+
+    double fdRate = (bumped(initialRate + h, 0.01, 0.2) - bumped(initialRate - h, 0.01, 0.2)) / (2 * h);
+    double fdVol = (bumped(initialRate, 0.01 + h, 0.2) - bumped(initialRate, 0.01 - h, 0.2)) / (2 * h);
+    double fdBlack = (bumped(initialRate, 0.01, 0.2 + h) - bumped(initialRate, 0.01, 0.2 - h)) / (2 * h);
+
+    REQUIRE(s.InitialRate == Approx(fdRate).epsilon(1e-4));
+    REQUIRE(s.Volatility == Approx(fdVol).epsilon(1e-3));
+    REQUIRE(s.BlackVolatility == Approx(fdBlack).epsilon(1e-4));
+
+    // Option value increases with volatility
+    REQUIRE(s.BlackVolatility > 0);
+}
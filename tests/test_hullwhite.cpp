@@ -0,0 +1,112 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "HullWhiteModel.hpp"
+#include "RateSimulator.hpp"
+#include "YieldCurve.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Upward sloping curve with smooth forwards
+YieldCurve testCurve() {
+    std::vector<double> times = {0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0};
+    std::vector<double> zeros = {0.020, 0.022, 0.025, 0.028, 0.032, 0.034, 0.036};
+    std::vector<double> dfs;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        dfs.push_back(std::exp(-zeros[i] * times[i]));
+    }
+    return YieldCurve(times, dfs, Interpolation::MonotoneConvex);
+}
+
+TEST_CASE("Hull-White reprices the initial curve analytically", "[HullWhiteModel]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+
+    for (double T : {0.25, 1.0, 2.5, 5.0, 9.0}) {
+        REQUIRE(model.zeroCouponBondPrice(model.initialRate(), 0.0, T) == Approx(curve.discountFactor(T)).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("Hull-White Monte Carlo reprices the curve", "[HullWhiteModel]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    RateSimulator simulator;
+
+    double timeStep = 0.01;
+    unsigned int steps = 500;
+    unsigned int numPaths = 20000;
+    model.prepareGrid(timeStep, steps);
+
+    std::vector<double> normals = simulator.generateNormals(numPaths, steps, 9);
+    std::vector<double> paths = simulator.simulatePathBlock(model, model.initialRate(), timeStep, steps, normals);
+
+    double sum = 0.0;
+    double optionSum = 0.0;
+    double expiry = 2.0;
+    unsigned int expiryIndex = static_cast<unsigned int>(expiry / timeStep) - 1;
+    for (unsigned int p = 0; p < numPaths; ++p) {
+        const double* path = &paths[p * steps];
+        double integral = 0.5 * model.initialRate();
+        double integralToExpiry = 0.0;
+        for (unsigned int i = 0; i + 1 < steps; ++i) {
+            integral += path[i];
+            if (i + 1 == expiryIndex + 1) {
+                integralToExpiry = integral - 0.5 * path[i];
+            }
+        }
+        integral += 0.5 * path[steps - 1];
+        sum += std::exp(-integral * timeStep);
+
+        // Call on the 5y zero struck at the forward, paid at expiry
+        double bond = model.zeroCouponBondPrice(path[expiryIndex], expiry, 5.0);
+        double strike = curve.discountFactor(5.0) / curve.discountFactor(expiry);
+        optionSum += std::exp(-integralToExpiry * timeStep) * std::max(bond - strike, 0.0);
+    }
+
+    REQUIRE(sum / numPaths == Approx(curve.discountFactor(5.0)).epsilon(0.002));
+
+    double strike = curve.discountFactor(5.0) / curve.discountFactor(expiry);
+    REQUIRE(optionSum / numPaths == Approx(model.zeroCouponBondOption(expiry, 5.0, strike, true)).epsilon(0.05));
+}
+
+TEST_CASE("Drift table matches direct evaluation", "[HullWhiteModel]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel tabled(0.1, 0.01, curve);
+    HullWhiteModel direct(0.1, 0.01, curve);
+    tabled.prepareGrid(0.05, 200);
+
+    double a = tabled.initialRate();
+    double b = direct.initialRate();
+    for (unsigned int i = 0; i < 200; ++i) {
+        double dw = std::sin(i);
+        a = tabled.nextRate(a, i * 0.05, 0.05, dw);
+        b = direct.nextRate(b, i * 0.05, 0.05, dw);
+        REQUIRE(a == Approx(b).epsilon(1e-12));
+    }
+
+    // The stateful interface follows the same clock
+    RateSimulator simulator;
+    std::vector<double> path = simulator.simulatePaths(tabled, tabled.initialRate(), 0.05, 200);
+    REQUIRE(path.size() == 200);
+    REQUIRE(std::isfinite(path.back()));
+}
+
+TEST_CASE("Zero-coupon option put-call parity", "[HullWhiteModel]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.2, 0.015, curve);
+
+    double expiry = 1.0;
+    double maturity = 4.0;
+    for (double strike : {0.85, 0.9, 0.95}) {
+        double call = model.zeroCouponBondOption(expiry, maturity, strike, true);
+        double put = model.zeroCouponBondOption(expiry, maturity, strike, false);
+        double forward = curve.discountFactor(maturity) - strike * curve.discountFactor(expiry);
+        REQUIRE(call - put == Approx(forward).margin(1e-12));
+        REQUIRE(call >= 0.0);
+        REQUIRE(put >= 0.0);
+    }
+
+    // theta(t) makes the model mean follow the curve's forward
+    REQUIRE(std::isfinite(model.theta(3.0)));
+}
@@ -0,0 +1,59 @@
+#define CATCH_CONFIG_MAIN
+#define IRMODELING_INSTRUMENT
+#include "catch.hpp"
+#include "Instrumentation.hpp"
+#include "ParallelFor.hpp"
+#include <sstream>
+#include <string>
+
+namespace {
+    void recordWork(unsigned int n){
+        IR_PROFILE_SCOPE(Stepping);
+        IR_COUNT(Steps, n);
+        IR_COUNT(Paths, 1);
+    }
+}
+
+TEST_CASE("Counters from every thread are summed", "[Instrumentation]") {
+    Instrumentation::reset();
+    parallelFor(64, 4, [](std::size_t i, unsigned int){
+        recordWork(static_cast<unsigned int>(i));
+    });
+
+    Instrumentation::ThreadProfile sum = Instrumentation::totals();
+    REQUIRE(sum.Counters[static_cast<std::size_t>(ProfileCounter::Steps)] == 64 * 63 / 2);
+    REQUIRE(sum.Counters[static_cast<std::size_t>(ProfileCounter::Paths)] == 64);
+    REQUIRE(sum.Calls[static_cast<std::size_t>(ProfilePhase::Stepping)] == 64);
+    REQUIRE(sum.Calls[static_cast<std::size_t>(ProfilePhase::Payoff)] == 0);
+}
+
+TEST_CASE("Profiles of finished threads are reused", "[Instrumentation]") {
+    for (int round = 0; round < 5; ++round){
+        parallelFor(16, 4, [](std::size_t, unsigned int){ recordWork(1); });
+    }
+    // The main thread plus at most one slot per concurrent worker
+    REQUIRE(Instrumentation::threadCount() <= 5);
+}
+
+TEST_CASE("Reset clears the totals and the report lists every phase", "[Instrumentation]") {
+    recordWork(10);
+    Instrumentation::reset();
+    Instrumentation::ThreadProfile sum = Instrumentation::totals();
+    REQUIRE(sum.Counters[static_cast<std::size_t>(ProfileCounter::Steps)] == 0);
+    REQUIRE(sum.Ticks[static_cast<std::size_t>(ProfilePhase::Stepping)] == 0);
+
+    {
+        ScopedTimer timer(ProfilePhase::Io);
+        volatile double x = 0.0;
+        for (int i = 0; i < 100000; ++i) x = x + 1.0;
+    }
+    sum = Instrumentation::totals();
+    REQUIRE(sum.Ticks[static_cast<std::size_t>(ProfilePhase::Io)] > 0);
+    REQUIRE(Instrumentation::ticksPerSecond() > 0.0);
+
+    std::ostringstream out;
+    Instrumentation::report(out);
+    for (const char* name : {"rng", "stepping", "payoff", "io", "rejected samples"}){
+        REQUIRE(out.str().find(name) != std::string::npos);
+    }
+}
@@ -0,0 +1,77 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "LongstaffSchwartz.hpp"
+#include "TrinomialTree.hpp"
+#include "HullWhiteModel.hpp"
+#include "CIRModel.hpp"
+#include "YieldCurve.hpp"
+
+#include <cmath>
+#include <vector>
+
+YieldCurve testCurve() {
+    std::vector<double> times = {0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0};
+    std::vector<double> zeros = {0.020, 0.022, 0.025, 0.028, 0.032, 0.034, 0.036};
+    std::vector<double> dfs;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        dfs.push_back(std::exp(-zeros[i] * times[i]));
+    }
+    return YieldCurve(times, dfs, Interpolation::MonotoneConvex);
+}
+
+TEST_CASE("Single-exercise LSM matches the tree's European price", "[LongstaffSchwartz]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    model.prepareGrid(0.01, 500);
+
+    LongstaffSchwartz engine(20000, 0.01, 500, 11);
+    TrinomialTree tree(model, model.initialRate(), 5.0, 500);
+
+    double mc = engine.priceBermudanSwaption(model, model.initialRate(), {2.0}, 5.0, 0.035, 1.0, 100.0, true);
+    double lattice = tree.priceBermudanSwaption({2.0}, 5.0, 0.035, 1.0, 100.0, true);
+    REQUIRE(mc == Approx(lattice).epsilon(0.03));
+}
+
+TEST_CASE("LSM Bermudan swaption agrees with the tree", "[LongstaffSchwartz]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    model.prepareGrid(0.01, 500);
+
+    LongstaffSchwartz engine(20000, 0.01, 500, 12);
+    TrinomialTree tree(model, model.initialRate(), 5.0, 500);
+    std::vector<double> dates = {1.0, 2.0, 3.0, 4.0};
+
+    double european = engine.priceBermudanSwaption(model, model.initialRate(), {1.0}, 5.0, 0.03, 1.0, 100.0, false);
+    double mc = engine.priceBermudanSwaption(model, model.initialRate(), dates, 5.0, 0.03, 1.0, 100.0, false);
+    double lattice = tree.priceBermudanSwaption(dates, 5.0, 0.03, 1.0, 100.0, false);
+    REQUIRE(mc > european);
+    REQUIRE(mc == Approx(lattice).epsilon(0.05));
+}
+
+TEST_CASE("LSM callable bond is below the straight bond and matches the tree", "[LongstaffSchwartz]") {
+    CIRModel model(0.3, 0.04, 0.08);
+    double r0 = 0.03;
+    Bond bond(100, 5, 0.05, 0.5);
+    std::vector<double> callDates = {1.0, 2.0, 3.0, 4.0};
+
+    LongstaffSchwartz engine(10000, 0.01, 500, 13);
+    TrinomialTree tree(model, r0, 5.0, 500);
+
+    double straight = tree.priceBond(bond);
+    double mc = engine.priceCallableBond(model, r0, bond, callDates, 100.0);
+    double lattice = tree.priceCallableBond(bond, callDates, 100.0);
+    REQUIRE(mc < straight);
+    REQUIRE(mc == Approx(lattice).epsilon(0.005));
+}
+
+TEST_CASE("LSM prices do not depend on the thread count", "[LongstaffSchwartz]") {
+    CIRModel model(0.3, 0.04, 0.08);
+    LongstaffSchwartz serial(3000, 0.01, 300, 5, 1, 128);
+    LongstaffSchwartz threaded(3000, 0.01, 300, 5, 4, 128);
+
+    std::vector<double> dates = {0.5, 1.0, 1.5, 2.0, 2.5};
+    double a = serial.priceBermudanSwaption(model, 0.03, dates, 3.0, 0.04, 2.0, 100.0, true);
+    double b = threaded.priceBermudanSwaption(model, 0.03, dates, 3.0, 0.04, 2.0, 100.0, true);
+    REQUIRE(a > 0.0);
+    REQUIRE(a == b);
+}
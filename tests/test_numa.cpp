@@ -0,0 +1,103 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "NumaTopology.hpp"
+#include "NumaPathEngine.hpp"
+#include "RateSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "Bond.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+TEST_CASE("CPU lists are parsed like sysfs writes them", "[NumaTopology]") {
+    REQUIRE(NumaTopology::parseCpuList("0-3,8-9") == std::vector<int>{0, 1, 2, 3, 8, 9});
+    REQUIRE(NumaTopology::parseCpuList("5\n") == std::vector<int>{5});
+    REQUIRE(NumaTopology::parseCpuList("").empty());
+}
+
+TEST_CASE("Nodes are read from a sysfs tree and limited to allowed CPUs", "[NumaTopology]") {
+    int cpu = NumaTopology::allowedCpus().front();
+    std::string root = "numa_test_sysfs";
+    std::vector<std::string> lists = {std::to_string(cpu), std::to_string(cpu) + "-" + std::to_string(cpu), "", "100000"};
+    mkdir(root.c_str(), 0755);
+    for (std::size_t n = 0; n < lists.size(); ++n){
+        std::string dir = root + "/node" + std::to_string(n);
+        mkdir(dir.c_str(), 0755);
+        std::ofstream(dir + "/cpulist") << lists[n] << "\n";
+    }
+
+    NumaTopology topology = NumaTopology::detect(root);
+    REQUIRE(topology.numNodes() == 2);
+    REQUIRE(topology.node(0).Id == 0);
+    REQUIRE(topology.node(1).Id == 1);
+    REQUIRE(topology.node(1).Cpus == std::vector<int>{cpu});
+    REQUIRE(topology.restrict(1).numNodes() == 1);
+
+    for (std::size_t n = 0; n < lists.size(); ++n){
+        std::string dir = root + "/node" + std::to_string(n);
+        std::remove((dir + "/cpulist").c_str());
+        rmdir(dir.c_str());
+    }
+    rmdir(root.c_str());
+
+    // No sysfs at all: one node with every allowed CPU
+    NumaTopology fallback = NumaTopology::detect("does_not_exist");
+    REQUIRE(fallback.numNodes() == 1);
+    REQUIRE(fallback.numCpus() == NumaTopology::allowedCpus().size());
+}
+
+TEST_CASE("Prices do not depend on the node layout", "[NumaPathEngine]") {
+    CIRModel model(0.3, 0.05, 0.05);
+    int cpu = NumaTopology::allowedCpus().front();
+    NumaTopology oneNode(std::vector<NumaNode>{{0, {cpu}}});
+    NumaTopology twoNodes(std::vector<NumaNode>{{0, {cpu}}, {1, {cpu}}});
+
+    std::vector<Bond> bonds = {Bond(1000, 5, 0.05, 0.5), Bond(1000, 8, 0.04, 1)};
+    std::vector<SwaptionTrade> swaptions = {{Swaption(0.05, 2, 1000, 3), 0.2, 4, true}};
+    unsigned int numPaths = 1000, steps = 240, seed = 17;
+    double timeStep = 0.05;
+
+    NumaPathEngine single(oneNode, 1, 64);
+    single.simulate(model, 0.03, timeStep, steps, numPaths, seed);
+    std::vector<double> expected = single.price(bonds, swaptions);
+
+    NumaPathEngine split(twoNodes, 2, 64);
+    split.simulate(model, 0.03, timeStep, steps, numPaths, seed);
+    REQUIRE(split.nodeBlocks(0) + split.nodeBlocks(1) == 16);
+    REQUIRE(split.nodeBlocks(1) == 8);
+    std::vector<double> prices = split.price(bonds, swaptions);
+
+    REQUIRE(prices.size() == 3);
+    for (std::size_t k = 0; k < prices.size(); ++k){
+        REQUIRE(std::fabs(prices[k] - expected[k]) <= 1e-12 * std::fabs(expected[k]));
+    }
+
+    // The stored paths are the block normals pushed through RateSimulator
+    RateSimulator simulator;
+    std::vector<double> normals = simulator.generateNormals(64, steps, NumaPathEngine::blockSeed(seed, 9));
+    std::vector<double> reference = simulator.simulatePathBlock(model, 0.03, timeStep, steps, normals);
+    for (unsigned int i = 0; i < steps; ++i){
+        REQUIRE(split.path(9 * 64 + 5)[i] == reference[5 * steps + i]);
+    }
+}
+
+TEST_CASE("The engine agrees with a plain Monte Carlo estimate", "[NumaPathEngine]") {
+    VasicekModel model(0.3, 0.05, 0.01);
+    NumaPathEngine engine(NumaTopology::detect(), 0, 128);
+    engine.simulate(model, 0.03, 0.05, 200, 4000, 3);
+
+    Bond bond(1000, 5, 0.05, 0.5);
+    double price = engine.price({bond}, {})[0];
+
+    double sum = 0.0;
+    for (std::size_t p = 0; p < engine.numPaths(); ++p){
+        std::vector<double> rates(engine.path(p), engine.path(p) + engine.steps());
+        sum += bond.price(rates, 0.05);
+    }
+    REQUIRE(std::fabs(price - sum / engine.numPaths()) < 1e-9 * price);
+}
@@ -0,0 +1,90 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "ObservationSchedule.hpp"
+#include "RateSimulator.hpp"
+#include "TimeGrid.hpp"
+#include "CIRModel.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Schedules keep the instrument dates that are grid nodes", "[ObservationSchedule]") {
+    TimeGrid grid = TimeGrid::uniform(0.01, 1000);
+    Bond bond(100, 10, 0.05, 0.5);
+    ObservationSchedule schedule = ObservationSchedule::forInstruments(grid, {bond}, {Swaption(0.05, 2, 1000, 3)});
+
+    // 20 coupon dates (maturity and swap dates among them) instead of 1000 nodes
+    REQUIRE(schedule.size() == 20);
+    REQUIRE(grid.size() / schedule.size() == 50);
+    for (std::size_t k = 0; k < schedule.size(); ++k){
+        REQUIRE(grid.time(schedule.node(k)) == Approx(schedule.dates().time(k)));
+    }
+    REQUIRE_FALSE(schedule.integrals());
+
+    ObservationSchedule partial(grid, {0.5, 0.505, 20.0, 0.25});
+    REQUIRE(partial.size() == 2);
+    REQUIRE(partial.node(0) == 24);
+}
+
+TEST_CASE("Observed slices and integrals match the full paths", "[ObservationSchedule]") {
+    RateSimulator simulator;
+    CIRModel model(0.3, 0.04, 0.05);
+    TimeGrid grid = TimeGrid::forInstruments({Bond(100, 5, 0.05, 0.5)}, {}, 0.02);
+    ObservationSchedule schedule(grid, {0.5, 1.5, 2.0, 5.0}, true);
+    const unsigned int paths = 50;
+    std::vector<double> normals = simulator.generateNormals(paths, grid.size(), 4);
+
+    std::vector<double> full(normals.size());
+    simulator.simulatePathBlock(model, 0.03, grid, normals.data(), paths, full.data());
+    ObservedPaths observed = simulator.simulateObserved(model, 0.03, grid, schedule, normals);
+    REQUIRE(observed.Rates.size() == paths * schedule.size());
+    REQUIRE(observed.Integrals.size() == observed.Rates.size());
+
+    for (unsigned int p = 0; p < paths; ++p){
+        const double* path = full.data() + p * grid.size();
+        double integral = 0.0, previous = 0.03;
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < grid.size() && k < schedule.size(); ++i){
+            integral += 0.5 * (previous + path[i]) * grid.step(i);
+            previous = path[i];
+            if (i == schedule.node(k)){
+                REQUIRE(observed.Rates[p * schedule.size() + k] == path[i]);
+                REQUIRE(observed.Integrals[p * schedule.size() + k] == Approx(integral).epsilon(1e-12));
+                ++k;
+            }
+        }
+    }
+}
+
+TEST_CASE("Instruments price off the observed slices", "[ObservationSchedule]") {
+    RateSimulator simulator;
+    CIRModel model(0.3, 0.04, 0.05);
+    Bond bond(100, 4, 0.05, 0.5);
+    Swaption swaption(0.04, 1, 1000, 2);
+    TimeGrid grid = TimeGrid::forInstruments({bond}, {swaption}, 0.01);
+    ObservationSchedule schedule = ObservationSchedule::forInstruments(grid, {bond}, {swaption}, true);
+    const unsigned int paths = 20;
+    std::vector<double> normals = simulator.generateNormals(paths, grid.size(), 9);
+
+    std::vector<double> full(normals.size());
+    simulator.simulatePathBlock(model, 0.03, grid, normals.data(), paths, full.data());
+    ObservedPaths observed = simulator.simulateObserved(model, 0.03, grid, schedule, normals);
+
+    std::vector<CashFlow> fullFlows = bond.cashFlowSchedule(grid);
+    std::vector<CashFlow> observedFlows = bond.cashFlowSchedule(schedule.dates());
+    for (unsigned int p = 0; p < paths; ++p){
+        const double* path = full.data() + p * grid.size();
+        const double* rates = observed.Rates.data() + p * schedule.size();
+        REQUIRE(Bond::price(rates, observedFlows) == Bond::price(path, fullFlows));
+
+        // Trapezoidal mean over the swap period from the full path
+        int first = grid.index(1.0), last = grid.index(3.0);
+        double sum = 0.0;
+        for (int i = first + 1; i <= last; ++i) sum += 0.5 * (path[i - 1] + path[i]) * grid.step(i);
+        double expected = swaption.priceFromForward(sum / 2.0, 0.2, 1, true);
+        double price = swaption.priceFromIntegrals(observed.Integrals.data() + p * schedule.size(), schedule.dates(), 0.2, 1, true);
+        REQUIRE(price == Approx(expected).epsilon(1e-10));
+    }
+}
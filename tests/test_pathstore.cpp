@@ -0,0 +1,86 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "PathStore.hpp"
+#include "RateSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Path file round-trips the simulated paths", "[PathStore]") {
+    VasicekModel model(0.3, 0.05, 0.01);
+    RateSimulator simulator;
+    const std::string filename = "test_paths_double.bin";
+    unsigned int numPaths = 1000;
+    unsigned int steps = 50;
+
+    REQUIRE(PathStore::write<double>(filename, model, "Vasicek", 0.03, 0.02, steps, numPaths, 7, 128));
+    std::vector<double> normals = simulator.generateNormals(numPaths, steps, 7);
+    std::vector<double> expected = simulator.simulatePathBlock(model, 0.03, 0.02, steps, normals);
+
+    PathStore store;
+    REQUIRE(store.open(filename));
+    REQUIRE(store.numPaths() == numPaths);
+    REQUIRE(store.steps() == steps);
+    REQUIRE(store.numBlocks() == 8);
+    REQUIRE(store.blockSize(7) == numPaths - 7 * 128);
+    REQUIRE(std::string(store.header().Model) == "Vasicek");
+    REQUIRE(store.header().Seed == 7);
+    REQUIRE(store.header().TimeStep == 0.02);
+    REQUIRE(store.header().MeanReversion == 0.3);
+    REQUIRE(store.block<float>(0) == nullptr);
+
+    for (std::size_t b = 0; b < store.numBlocks(); ++b) {
+        const double* rates = store.block<double>(b);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rates) % PathStoreHeader::Alignment == 0);
+        for (std::size_t i = 0; i < store.blockSize(b) * steps; ++i) {
+            REQUIRE(rates[i] == expected[b * 128 * steps + i]);
+        }
+    }
+    store.close();
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Step-major float path file matches the float simulation", "[PathStore]") {
+    CIRModel model(0.3, 0.05, 0.05);
+    RateSimulator simulator;
+    const std::string filename = "test_paths_float.bin";
+    unsigned int numPaths = 300;
+    unsigned int steps = 40;
+
+    REQUIRE(PathStore::write<float>(filename, model, "CIR", 0.03, 0.05, steps, numPaths, 11, 64, PathLayout::StepMajor));
+    std::vector<float> normals = simulator.generateNormals<float>(numPaths, steps, 11);
+    std::vector<float> expected = simulator.simulatePathBlock(model, 0.03, 0.05, steps, normals);
+
+    PathStore store;
+    REQUIRE(store.open(filename));
+    REQUIRE(store.header().Layout == PathLayout::StepMajor);
+    REQUIRE(store.header().ScalarBytes == sizeof(float));
+    for (unsigned int p = 0; p < numPaths; ++p) {
+        for (unsigned int i = 0; i < steps; ++i) {
+            REQUIRE(store.rate<float>(p, i) == expected[static_cast<std::size_t>(p) * steps + i]);
+        }
+    }
+
+    // A cross-section at one step is contiguous within a block
+    const float* first = store.block<float>(0);
+    REQUIRE(first[10 * 64 + 5] == expected[5 * steps + 10]);
+    store.close();
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Files that are not path files are rejected", "[PathStore]") {
+    const std::string filename = "test_paths_invalid.bin";
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out << std::string(8192, 'x');
+    }
+    PathStore store;
+    REQUIRE_FALSE(store.open(filename));
+    REQUIRE_FALSE(store.open("does_not_exist.bin"));
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,110 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "CrankNicolsonSolver.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "HullWhiteModel.hpp"
+#include "YieldCurve.hpp"
+
+#include <cmath>
+#include <vector>
+
+YieldCurve testCurve() {
+    std::vector<double> times = {0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0};
+    std::vector<double> zeros = {0.020, 0.022, 0.025, 0.028, 0.032, 0.034, 0.036};
+    std::vector<double> dfs;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        dfs.push_back(std::exp(-zeros[i] * times[i]));
+    }
+    return YieldCurve(times, dfs, Interpolation::MonotoneConvex);
+}
+
+// Bond price from the model's closed-form zero-coupon prices
+double analyticBond(const InterestRateModel& model, double r0, const Bond& bond) {
+    double value = 0.0;
+    for (const CashFlow& cf : bond.cashFlows()) {
+        value += cf.Amount * model.zeroCouponBondPrice(r0, 0.0, cf.Time);
+    }
+    return value;
+}
+
+TEST_CASE("PDE bond prices match the affine formulas", "[CrankNicolsonSolver]") {
+    VasicekModel vasicek(0.3, 0.04, 0.01);
+    CIRModel cir(0.3, 0.04, 0.08);
+    double r0 = 0.03;
+    std::vector<Bond> bonds = {Bond(100, 1, 0.0, 1), Bond(100, 5, 0.04, 0.5), Bond(1000, 10, 0.05, 1)};
+
+    CrankNicolsonSolver solver;
+    std::vector<double> vasicekPrices = solver.priceBonds(vasicek, r0, bonds);
+    std::vector<double> cirPrices = solver.priceBonds(cir, r0, bonds);
+    REQUIRE(vasicekPrices.size() == bonds.size());
+    for (std::size_t k = 0; k < bonds.size(); ++k) {
+        REQUIRE(vasicekPrices[k] == Approx(analyticBond(vasicek, r0, bonds[k])).epsilon(1e-5));
+        REQUIRE(cirPrices[k] == Approx(analyticBond(cir, r0, bonds[k])).epsilon(1e-5));
+    }
+}
+
+TEST_CASE("PDE reprices the Hull-White initial curve", "[CrankNicolsonSolver]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    std::vector<Bond> bonds = {Bond(100, 2, 0.0, 1), Bond(100, 7, 0.035, 0.5)};
+
+    CrankNicolsonSolver solver(201, 200);
+    std::vector<double> prices = solver.priceBonds(model, model.initialRate(), bonds);
+    for (std::size_t k = 0; k < bonds.size(); ++k) {
+        REQUIRE(prices[k] == Approx(bonds[k].price(curve)).epsilon(1e-4));
+    }
+}
+
+TEST_CASE("PDE European swaption matches Jamshidian's formula", "[CrankNicolsonSolver]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    double expiry = 2.0;
+    double fixedRate = 0.035;
+    std::vector<double> payTimes = {3.0, 4.0, 5.0};
+    std::vector<double> amounts = {fixedRate, fixedRate, 1.0 + fixedRate};
+
+    double lo = -0.5;
+    double hi = 0.5;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        double value = 0.0;
+        for (std::size_t k = 0; k < payTimes.size(); ++k) {
+            value += amounts[k] * model.zeroCouponBondPrice(mid, expiry, payTimes[k]);
+        }
+        (value > 1.0 ? lo : hi) = mid;
+    }
+    double rStar = 0.5 * (lo + hi);
+    double jamshidian = 0.0;
+    for (std::size_t k = 0; k < payTimes.size(); ++k) {
+        double strike = model.zeroCouponBondPrice(rStar, expiry, payTimes[k]);
+        jamshidian += amounts[k] * model.zeroCouponBondOption(expiry, payTimes[k], strike, false);
+    }
+
+    CrankNicolsonSolver solver;
+    std::vector<double> prices = solver.priceSwaptions(model, model.initialRate(), {Swaption(fixedRate, expiry, 100.0, 3.0)}, 1.0, true);
+    REQUIRE(prices[0] == Approx(100.0 * jamshidian).epsilon(2e-3));
+}
+
+TEST_CASE("PDE swaptions satisfy put-call parity", "[CrankNicolsonSolver]") {
+    CIRModel model(0.3, 0.04, 0.08);
+    double r0 = 0.03;
+    std::vector<Swaption> swaptions = {Swaption(0.03, 1.0, 100.0, 2.0), Swaption(0.045, 3.0, 100.0, 5.0)};
+    double f = 2.0;
+
+    CrankNicolsonSolver solver;
+    std::vector<double> payers = solver.priceSwaptions(model, r0, swaptions, f, true);
+    std::vector<double> receivers = solver.priceSwaptions(model, r0, swaptions, f, false);
+    for (std::size_t k = 0; k < swaptions.size(); ++k) {
+        const Swaption& s = swaptions[k];
+        int payments = static_cast<int>(s.swapLength() * f);
+        double forwardSwap = model.zeroCouponBondPrice(r0, 0.0, s.maturity());
+        for (int p = 1; p <= payments; ++p) {
+            double pay = s.maturity() + p / f;
+            forwardSwap -= (s.strikeRate() / f + (p == payments ? 1.0 : 0.0)) * model.zeroCouponBondPrice(r0, 0.0, pay);
+        }
+        REQUIRE(payers[k] > 0.0);
+        REQUIRE(receivers[k] > 0.0);
+        REQUIRE(payers[k] - receivers[k] == Approx(s.notional() * forwardSwap).margin(1e-4));
+    }
+}
@@ -0,0 +1,78 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "RateSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+#include "Precision.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_same<Accumulator<float>, double>::value, "float paths accumulate in double");
+static_assert(std::is_same<Accumulator<double>, double>::value, "double paths accumulate in double");
+
+// Monte Carlo bond and swaption prices from the same normals in both precisions
+template<typename Model>
+void comparePrecision(const Model& model, double initialRate, double rateTolerance, double priceTolerance) {
+    RateSimulator simulator;
+    double timeStep = 0.01;
+    unsigned int steps = 1000;
+    unsigned int numPaths = 2000;
+
+    std::vector<double> normals = simulator.generateNormals(numPaths, steps, 21);
+    std::vector<float> normalsFloat = simulator.generateNormals<float>(numPaths, steps, 21);
+    std::vector<double> paths = simulator.simulatePathBlock(model, initialRate, timeStep, steps, normals);
+    std::vector<float> pathsFloat = simulator.simulatePathBlock(model, initialRate, timeStep, steps, normalsFloat);
+
+    double maxRateError = 0.0;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        maxRateError = std::max(maxRateError, std::fabs(paths[i] - pathsFloat[i]));
+    }
+
+    Bond bond(1000, 10, 0.05, 0.5);
+    Swaption swaption(0.05, 2.0, 1000000, 5.0);
+    std::vector<CashFlow> schedule = bond.cashFlowSchedule(timeStep, steps);
+    double bondSum = 0.0, bondSumFloat = 0.0;
+    double swaptionSum = 0.0, swaptionSumFloat = 0.0;
+    for (unsigned int p = 0; p < numPaths; ++p) {
+        const double* path = &paths[static_cast<std::size_t>(p) * steps];
+        const float* pathFloat = &pathsFloat[static_cast<std::size_t>(p) * steps];
+        bondSum += Bond::price(path, schedule);
+        bondSumFloat += Bond::price(pathFloat, schedule);
+        swaptionSum += swaption.price(path, steps, 0.2, timeStep, 4, true);
+        swaptionSumFloat += swaption.price(pathFloat, steps, 0.2, timeStep, 4, true);
+    }
+
+    INFO("max rate error " << maxRateError << ", bond " << bondSum / numPaths << " vs " << bondSumFloat / numPaths
+         << ", swaption " << swaptionSum / numPaths << " vs " << swaptionSumFloat / numPaths);
+    REQUIRE(maxRateError < rateTolerance);
+    REQUIRE(bondSumFloat == Approx(bondSum).epsilon(priceTolerance));
+    REQUIRE(swaptionSumFloat == Approx(swaptionSum).epsilon(priceTolerance));
+}
+
+TEST_CASE("Float Vasicek paths price within single precision error", "[Precision]") {
+    comparePrecision(VasicekModel(0.3, 0.05, 0.01), 0.05, 1e-6, 1e-6);
+}
+
+TEST_CASE("Float CIR paths price within single precision error", "[Precision]") {
+    comparePrecision(CIRModel(0.3, 0.05, 0.05), 0.05, 1e-6, 1e-6);
+}
+
+TEST_CASE("Double paths are unchanged by the templated kernel", "[Precision]") {
+    VasicekModel model(0.3, 0.05, 0.01);
+    RateSimulator simulator;
+    std::vector<double> normals = simulator.generateNormals(10, 100, 3);
+    std::vector<double> paths = simulator.simulatePathBlock(model, 0.05, 0.01, 100, normals);
+
+    for (unsigned int p = 0; p < 10; ++p) {
+        double rate = 0.05;
+        for (unsigned int i = 0; i < 100; ++i) {
+            rate = model.nextRate(rate, i * 0.01, 0.01, normals[p * 100 + i]);
+            REQUIRE(paths[p * 100 + i] == rate);
+        }
+    }
+}
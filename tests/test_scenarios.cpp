@@ -0,0 +1,87 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "RateSimulator.hpp"
+#include "ScenarioEngine.hpp"
+
+#include <vector>
+
+// Compiled schedules must price exactly like Bond::price
+TEST_CASE("Compiled bond schedule matches direct pricing", "[ScenarioEngine]") {
+    RateSimulator simulator;
+    VasicekModel model(0.1, 0.05, 0.01);
+    Bond bond(1000, 10, 0.05, 0.5);
+    double timeStep = 0.05;
+    unsigned int steps = 150; // shorter than the bond, exercises index clamping
+
+    std::vector<double> rates = simulator.simulatePaths(model, 0.03, timeStep, steps);
+    std::vector<CashFlow> schedule = bond.cashFlowSchedule(timeStep, steps);
+
+    REQUIRE(Bond::price(rates.data(), schedule) == Approx(bond.price(rates, timeStep)).epsilon(1e-14));
+}
+
+TEST_CASE("Base scenario equals plain Monte Carlo on the same normals", "[ScenarioEngine]") {
+    RateSimulator simulator;
+    CIRModel model(0.1, 0.05, 0.01);
+    Bond bond(1000, 10, 0.05, 0.5);
+    Swaption swaption(0.05, 5, 1000, 1);
+    double initialRate = 0.03;
+    double timeStep = 0.05;
+    unsigned int steps = 220;
+    unsigned int numPaths = 500;
+    unsigned int seed = 11;
+
+    std::vector<double> normals = simulator.generateNormals(numPaths, steps, seed);
+    std::vector<double> paths = simulator.simulatePathBlock(model, initialRate, timeStep, steps, normals);
+
+    double bondSum = 0.0;
+    double swaptionSum = 0.0;
+    for (unsigned int p = 0; p < numPaths; ++p) {
+        std::vector<double> path(paths.begin() + p * steps, paths.begin() + (p + 1) * steps);
+        bondSum += bond.price(path, timeStep);
+        swaptionSum += swaption.price(path, 0.2, timeStep, 4, true);
+    }
+
+    ScenarioEngine engine(numPaths, timeStep, steps, seed, 2, 64);
+    std::vector<ScenarioResult> results = engine.run(model, initialRate, {Scenario{"base"}},
+                                                     {bond}, {SwaptionTrade{swaption, 0.2, 4, true}});
+
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].Name == "base");
+    REQUIRE(results[0].BondPrices[0] == Approx(bondSum / numPaths).epsilon(1e-12));
+    REQUIRE(results[0].SwaptionPrices[0] == Approx(swaptionSum / numPaths).epsilon(1e-12));
+}
+
+TEST_CASE("Scenario results are independent of thread count", "[ScenarioEngine]") {
+    // CIR keeps the forward swap rate positive for Black's formula
+    CIRModel model(0.1, 0.05, 0.01);
+    std::vector<Bond> bonds = {Bond(1000, 10, 0.05, 0.5), Bond(100, 2, 0.03, 1)};
+    std::vector<SwaptionTrade> swaptions = {SwaptionTrade{Swaption(0.05, 5, 1000, 1), 0.2, 4, true}};
+
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(Scenario{"base"});
+    Scenario up{"ltm +100bp"};
+    up.LongTermMeanShift = 0.01;
+    scenarios.push_back(up);
+    Scenario vol{"swaption vol +5%"};
+    vol.SwaptionVolShift = 0.05;
+    scenarios.push_back(vol);
+
+    ScenarioEngine serial(1000, 0.05, 220, 3, 1, 100);
+    ScenarioEngine parallel(1000, 0.05, 220, 3, 4, 100);
+    std::vector<ScenarioResult> a = serial.run(model, 0.03, scenarios, bonds, swaptions);
+    std::vector<ScenarioResult> b = parallel.run(model, 0.03, scenarios, bonds, swaptions);
+
+    for (std::size_t s = 0; s < scenarios.size(); ++s) {
+        REQUIRE(a[s].BondPrices == b[s].BondPrices);
+        REQUIRE(a[s].SwaptionPrices == b[s].SwaptionPrices);
+    }
+
+    // Higher long-term mean lowers bond prices; higher Black vol raises option value
+    REQUIRE(a[1].BondPrices[0] < a[0].BondPrices[0]);
+    REQUIRE(a[2].SwaptionPrices[0] > a[0].SwaptionPrices[0]);
+    REQUIRE(a[2].BondPrices[0] == a[0].BondPrices[0]);
+}
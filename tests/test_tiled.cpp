@@ -0,0 +1,73 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "TiledSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Auto tile keeps a group within half of the cache", "[TiledSimulator]") {
+    TileShape tile = TiledSimulator::autoTile(250, 1u << 20);
+    REQUIRE(tile.Steps == 64);
+    REQUIRE(tile.Paths % 8 == 0);
+    REQUIRE(tile.Paths * tile.Steps * sizeof(double) <= (1u << 19));
+    REQUIRE(TiledSimulator::autoTile(10, 1u << 20).Steps == 10);
+    REQUIRE(TiledSimulator::autoTile(250, 1024).Paths == 8);
+    REQUIRE(TiledSimulator::l2CacheBytes() > 0);
+}
+
+TEST_CASE("Paths do not depend on the tile shape or thread count", "[TiledSimulator]") {
+    VasicekModel model(0.1, 0.05, 0.01);
+    unsigned int paths = 37, steps = 101;
+
+    TiledSimulator reference(paths, 0.01, steps, 7, 1);
+    reference.setTile({8, 101});
+    std::vector<double> expected(paths * steps);
+    reference.simulate(model, 0.03, expected.data());
+
+    std::vector<TileShape> shapes = {{8, 1}, {16, 7}, {40, 64}, {64, 200}};
+    for (const TileShape& shape : shapes){
+        TiledSimulator tiled(paths, 0.01, steps, 7, 3);
+        tiled.setTile(shape);
+        std::vector<double> out(paths * steps);
+        tiled.simulate(model, 0.03, out.data());
+        REQUIRE(out == expected);
+    }
+}
+
+TEST_CASE("Tiled prices match pricing the stored paths", "[TiledSimulator]") {
+    CIRModel model(0.3, 0.04, 0.05);
+    unsigned int paths = 300, steps = 250;
+    double dt = 0.04;
+    std::vector<Bond> bonds = {Bond(100, 5, 0.05, 2), Bond(1000, 9.5, 0.03, 1)};
+    std::vector<SwaptionTrade> swaptions = {{Swaption(0.04, 2, 1000000, 3), 0.2, 1, true},
+                                            {Swaption(0.05, 4, 1000000, 2), 0.25, 2, false}};
+
+    TiledSimulator tiled(paths, dt, steps, 11, 2);
+    tiled.setTile({24, 50});
+    std::vector<double> prices = tiled.price(model, 0.03, bonds, swaptions);
+
+    std::vector<double> stored(paths * steps);
+    tiled.simulate(model, 0.03, stored.data());
+    std::vector<double> expected(bonds.size() + swaptions.size(), 0.0);
+    for (unsigned int p = 0; p < paths; ++p){
+        const double* rates = stored.data() + p * steps;
+        for (std::size_t k = 0; k < bonds.size(); ++k){
+            expected[k] += Bond::price(rates, bonds[k].cashFlowSchedule(dt, steps));
+        }
+        for (std::size_t k = 0; k < swaptions.size(); ++k){
+            const SwaptionTrade& trade = swaptions[k];
+            expected[bonds.size() + k] += trade.Instrument.price(rates, steps, trade.Volatility, dt, trade.Frequency, trade.IsPayer);
+        }
+    }
+
+    REQUIRE(prices.size() == expected.size());
+    for (std::size_t k = 0; k < prices.size(); ++k){
+        expected[k] /= paths;
+        REQUIRE(prices[k] > 0.0);
+        REQUIRE(std::abs(prices[k] - expected[k]) <= 1e-10 * std::abs(expected[k]));
+    }
+}
@@ -0,0 +1,103 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "TimeGrid.hpp"
+#include "RateSimulator.hpp"
+#include "VasicekModel.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Dates are sorted, merged and refined", "[TimeGrid]") {
+    TimeGrid grid({2.0, 0.5, 0.0, 0.1 + 0.2, 0.3, -1.0, 2.0 + 1e-13});
+    REQUIRE(grid.size() == 3);
+    REQUIRE(grid.time(0) == Approx(0.3));
+    REQUIRE(grid.step(1) == Approx(0.2));
+    REQUIRE(grid.end() == 2.0);
+
+    TimeGrid refined({0.3, 2.0}, 0.25);
+    REQUIRE(refined.size() == 9);
+    for (std::size_t i = 0; i < refined.size(); ++i){
+        REQUIRE(refined.step(i) <= 0.25 + 1e-12);
+    }
+    REQUIRE(refined.index(0.3) == 1);
+    REQUIRE(refined.index(2.0) == 8);
+    REQUIRE(refined.index(1.0) == -1);
+}
+
+TEST_CASE("Cash flows find their own node instead of a truncated index", "[TimeGrid]") {
+    // 0.3 / 0.1 truncates to 2, one node early on the uniform grid
+    TimeGrid grid = TimeGrid::uniform(0.1, 10);
+    REQUIRE(static_cast<int>(0.3 / 0.1) == 2);
+    REQUIRE(grid.index(0.3) == 2);
+    REQUIRE(grid.time(2) == Approx(0.3));
+
+    Bond bond(100, 1.0, 0.05, 0.3);
+    std::vector<CashFlow> schedule = bond.cashFlowSchedule(grid);
+    for (const CashFlow& cf : schedule){
+        REQUIRE(grid.time(cf.RateIndex) == Approx(cf.Time));
+    }
+
+    // Reading rate[i] = t_i shows which node each flow used
+    std::vector<double> rates(grid.times());
+    double expected = 0.0;
+    for (const CashFlow& cf : bond.cashFlows()){
+        expected += cf.Amount * std::exp(-cf.Time * cf.Time);
+    }
+    REQUIRE(Bond::price(rates.data(), schedule) == Approx(expected).epsilon(1e-12));
+}
+
+TEST_CASE("An instrument grid holds only the needed dates", "[TimeGrid]") {
+    std::vector<Bond> bonds = {Bond(100, 5, 0.05, 0.5), Bond(100, 3, 0.04, 1)};
+    std::vector<Swaption> swaptions = {Swaption(0.05, 2, 1000, 1.5)};
+    TimeGrid grid = TimeGrid::forInstruments(bonds, swaptions);
+    REQUIRE(grid.size() == 10);
+    REQUIRE(grid.index(3.5) >= 0);
+
+    TimeGrid fine = TimeGrid::forInstruments(bonds, swaptions, 0.1);
+    REQUIRE(fine.size() == 50);
+    REQUIRE(fine.index(2.0) >= 0);
+}
+
+TEST_CASE("A uniform grid reproduces the timeStep simulation", "[TimeGrid]") {
+    RateSimulator simulator;
+    VasicekModel a(0.1, 0.05, 0.01), b(0.1, 0.05, 0.01);
+    a.seed(3);
+    b.seed(3);
+    REQUIRE(simulator.simulatePaths(a, 0.03, TimeGrid::uniform(0.04, 100)) == simulator.simulatePaths(b, 0.03, 0.04, 100));
+}
+
+TEST_CASE("Grid prices agree with exact prices on a deterministic path", "[TimeGrid]") {
+    // With no volatility and r0 at the long-term mean the rate stays flat on any grid
+    RateSimulator simulator;
+    VasicekModel model(0.2, 0.04, 0.0);
+    Bond bond(100, 5, 0.05, 0.5);
+    Swaption swaption(0.03, 2, 1000, 3);
+    TimeGrid grid = TimeGrid::forInstruments({bond}, {swaption}, 0.7);
+
+    double expected = 0.0;
+    for (const CashFlow& cf : bond.cashFlows()){
+        expected += cf.Amount * std::exp(-0.04 * cf.Time);
+    }
+    REQUIRE(simulator.priceBond(bond, model, 0.04, grid) == Approx(expected).epsilon(1e-12));
+
+    std::vector<double> rates = simulator.simulatePaths(model, 0.04, grid);
+    std::vector<double> flat(200, 0.04);
+    REQUIRE(swaption.price(rates.data(), grid, 0.2, 1, true) == Approx(swaption.price(flat, 0.2, 0.05, 1, true)).epsilon(1e-12));
+}
+
+TEST_CASE("Grid blocks follow the model with time-dependent steps", "[TimeGrid]") {
+    RateSimulator simulator;
+    VasicekModel model(0.3, 0.05, 0.02);
+    TimeGrid grid({0.25, 1.0, 1.1, 4.0});
+    std::vector<double> normals = {0.5, -1.0, 0.2, 1.5, -0.3, 0.0, 2.0, -2.0};
+    std::vector<double> out(normals.size());
+    simulator.simulatePathBlock(model, 0.03, grid, normals.data(), 2, out.data());
+
+    double r = 0.03;
+    for (std::size_t i = 0; i < grid.size(); ++i){
+        r = model.nextRate(r, grid.time(i) - grid.step(i), grid.step(i), normals[4 + i]);
+    }
+    REQUIRE(out[7] == r);
+}
@@ -0,0 +1,77 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "TraceRecorder.hpp"
+#include "ScenarioEngine.hpp"
+#include "VasicekModel.hpp"
+#include "Bond.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    std::string readFile(const std::string& filename){
+        std::ifstream in(filename);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+}
+
+TEST_CASE("Parallel engine runs are recorded as Chrome trace events", "[TraceRecorder]") {
+    VasicekModel model(0.3, 0.05, 0.01);
+    ScenarioEngine engine(1024, 0.05, 100, 7, 2, 128);
+    std::vector<Scenario> scenarios(2);
+    scenarios[1].InitialRateShift = 0.01;
+    std::vector<Bond> bonds = {Bond(1000, 4, 0.05, 0.5)};
+
+    TraceRecorder::start();
+    engine.run(model, 0.03, scenarios, bonds, {});
+    TraceRecorder::stop();
+
+    // Two scenarios x eight blocks, each simulated and priced, plus the reduction
+    REQUIRE(TraceRecorder::eventCount() == 2 * 8 * 2 + 1);
+    REQUIRE(TraceRecorder::droppedCount() == 0);
+
+    std::string filename = "test_trace.json";
+    REQUIRE(TraceRecorder::write(filename));
+    std::string json = readFile(filename);
+    std::remove(filename.c_str());
+
+    REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"simulate block\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"price block\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"reduce\"") != std::string::npos);
+    REQUIRE(json.find("\"args\":{\"items\":128}") != std::string::npos);
+
+    int depth = 0, minDepth = 0;
+    for (char c : json){
+        if (c == '{' || c == '[') ++depth;
+        if (c == '}' || c == ']') --depth;
+        minDepth = std::min(minDepth, depth);
+    }
+    REQUIRE(minDepth == 0);
+    REQUIRE(depth == 0);
+}
+
+TEST_CASE("Nothing is recorded while tracing is off", "[TraceRecorder]") {
+    TraceRecorder::start();
+    TraceRecorder::stop();
+    {
+        TraceScope scope("idle", "test");
+    }
+    REQUIRE(TraceRecorder::eventCount() == 0);
+}
+
+TEST_CASE("Full buffers drop events instead of growing", "[TraceRecorder]") {
+    TraceRecorder::start(4);
+    for (int i = 0; i < 10; ++i){
+        TraceScope scope("event", "test", i);
+    }
+    TraceRecorder::stop();
+    REQUIRE(TraceRecorder::eventCount() == 4);
+    REQUIRE(TraceRecorder::droppedCount() == 6);
+}
@@ -0,0 +1,98 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "TrinomialTree.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "HullWhiteModel.hpp"
+#include "Bond.hpp"
+#include "YieldCurve.hpp"
+
+#include <cmath>
+#include <vector>
+
+YieldCurve testCurve() {
+    std::vector<double> times = {0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0};
+    std::vector<double> zeros = {0.020, 0.022, 0.025, 0.028, 0.032, 0.034, 0.036};
+    std::vector<double> dfs;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        dfs.push_back(std::exp(-zeros[i] * times[i]));
+    }
+    return YieldCurve(times, dfs, Interpolation::MonotoneConvex);
+}
+
+TEST_CASE("Tree zero-coupon bonds match the affine formulas", "[TrinomialTree]") {
+    VasicekModel vasicek(0.3, 0.04, 0.01);
+    CIRModel cir(0.3, 0.04, 0.05);
+    double r0 = 0.03;
+
+    TrinomialTree vasicekTree(vasicek, r0, 5.0, 500);
+    TrinomialTree cirTree(cir, r0, 5.0, 500);
+    for (double T : {1.0, 2.0, 5.0}) {
+        REQUIRE(vasicekTree.priceZeroCouponBond(T) == Approx(vasicek.zeroCouponBondPrice(r0, 0.0, T)).epsilon(1e-4));
+        REQUIRE(cirTree.priceZeroCouponBond(T) == Approx(cir.zeroCouponBondPrice(r0, 0.0, T)).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("Hull-White tree reprices the initial curve", "[TrinomialTree]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    TrinomialTree tree(model, model.initialRate(), 10.0, 400);
+
+    for (double T : {0.5, 2.0, 7.5, 10.0}) {
+        REQUIRE(tree.priceZeroCouponBond(T) == Approx(curve.discountFactor(T)).epsilon(1e-10));
+    }
+    Bond bond(100, 5, 0.04, 0.5);
+    REQUIRE(tree.priceBond(bond) == Approx(bond.price(curve)).epsilon(1e-10));
+}
+
+TEST_CASE("Single-exercise Bermudan matches Jamshidian's formula", "[TrinomialTree]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    TrinomialTree tree(model, model.initialRate(), 5.0, 500);
+
+    // A payer swaption is a put on the fixed bond struck at par, decomposed into ZCB puts
+    double expiry = 2.0;
+    double swapEnd = 5.0;
+    double fixedRate = 0.035;
+    double frequency = 1.0;
+    std::vector<double> payTimes = {3.0, 4.0, 5.0};
+    std::vector<double> amounts = {fixedRate, fixedRate, 1.0 + fixedRate};
+
+    // Rate at expiry for which the fixed bond is worth par
+    double lo = -0.5;
+    double hi = 0.5;
+    for (int i = 0; i < 200; ++i) {
+        double mid = 0.5 * (lo + hi);
+        double value = 0.0;
+        for (std::size_t k = 0; k < payTimes.size(); ++k) {
+            value += amounts[k] * model.zeroCouponBondPrice(mid, expiry, payTimes[k]);
+        }
+        (value > 1.0 ? lo : hi) = mid;
+    }
+    double rStar = 0.5 * (lo + hi);
+    double jamshidian = 0.0;
+    for (std::size_t k = 0; k < payTimes.size(); ++k) {
+        double strike = model.zeroCouponBondPrice(rStar, expiry, payTimes[k]);
+        jamshidian += amounts[k] * model.zeroCouponBondOption(expiry, payTimes[k], strike, false);
+    }
+
+    double treePrice = tree.priceBermudanSwaption({expiry}, swapEnd, fixedRate, frequency, 1.0, true);
+    REQUIRE(treePrice == Approx(jamshidian).epsilon(5e-3));
+}
+
+TEST_CASE("Early exercise rights are ordered", "[TrinomialTree]") {
+    YieldCurve curve = testCurve();
+    HullWhiteModel model(0.1, 0.01, curve);
+    TrinomialTree tree(model, model.initialRate(), 10.0, 400);
+
+    double european = tree.priceBermudanSwaption({2.0}, 10.0, 0.035, 2.0, 1.0, false);
+    double bermudan = tree.priceBermudanSwaption({2.0, 3.0, 4.0, 5.0, 6.0}, 10.0, 0.035, 2.0, 1.0, false);
+    REQUIRE(european > 0.0);
+    REQUIRE(bermudan >= european);
+
+    Bond bond(100, 10, 0.05, 0.5);
+    double straight = tree.priceBond(bond);
+    double callable = tree.priceCallableBond(bond, {3.0, 5.0, 7.0}, 100.0);
+    REQUIRE(callable <= straight);
+    REQUIRE(callable > 0.9 * straight);
+}
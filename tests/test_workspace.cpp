@@ -0,0 +1,84 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "RateSimulator.hpp"
+#include "SimulationWorkspace.hpp"
+#include "VasicekModel.hpp"
+#include "CIRModel.hpp"
+#include "Bond.hpp"
+#include "Swaption.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Count every heap allocation made by the process
+namespace {
+    std::atomic<std::size_t> HeapAllocations(0);
+}
+
+void* operator new(std::size_t size){
+    ++HeapAllocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+TEST_CASE("Workspace calls give the same prices as the allocating calls", "[SimulationWorkspace]") {
+    VasicekModel a(0.3, 0.05, 0.01), b(0.3, 0.05, 0.01);
+    RateSimulator simulator;
+    Bond bond(1000, 5, 0.05, 0.5);
+    SimulationWorkspace workspace;
+
+    for (int i = 0; i < 10; ++i){
+        double expected = simulator.priceBond(bond, a, 0.03, 0.05, 200);
+        REQUIRE(simulator.priceBond(bond, b, 0.03, 0.05, 200, workspace) == expected);
+    }
+
+    Swaption swaption(0.05, 2, 1000, 3);
+    std::vector<double> rates = simulator.simulatePaths(a, 0.03, 0.05, 200);
+    double expected = swaption.price(rates, 0.2, 0.05, 4, true);
+    REQUIRE(simulator.priceSwaption(swaption, b, 0.03, 0.05, 200, 0.2, 4, true, workspace) == expected);
+}
+
+TEST_CASE("Pricing through a warm workspace does not allocate", "[SimulationWorkspace]") {
+    VasicekModel vasicek(0.3, 0.05, 0.01);
+    CIRModel cir(0.3, 0.05, 0.05);
+    RateSimulator simulator;
+    Bond bond(1000, 10, 0.05, 0.5);
+    Swaption swaption(0.05, 5, 1000, 5);
+    SimulationWorkspace workspace;
+
+    // Warm up at the largest size used below
+    simulator.priceBond(bond, vasicek, 0.03, 0.05, 400, workspace);
+    std::size_t capacity = workspace.capacity();
+
+    double sum = 0.0;
+    std::size_t before = HeapAllocations.load();
+    for (int i = 0; i < 1000; ++i){
+        sum += simulator.priceBond(bond, vasicek, 0.03, 0.05, 400, workspace);
+        sum += simulator.priceBond(bond, cir, 0.03, 0.05, 300, workspace);
+        sum += simulator.priceSwaption(swaption, vasicek, 0.03, 0.05, 400, 0.2, 4, true, workspace);
+        sum += simulator.priceSwaption(swaption, cir, 0.03, 0.05, 200, 0.2, 4, false, workspace);
+    }
+    std::size_t allocations = HeapAllocations.load() - before;
+
+    REQUIRE(allocations == 0);
+    REQUIRE(workspace.capacity() == capacity);
+    REQUIRE(sum > 0.0);
+}
+
+TEST_CASE("The allocating interface is caught by the counter", "[SimulationWorkspace]") {
+    VasicekModel vasicek(0.3, 0.05, 0.01);
+    RateSimulator simulator;
+    Bond bond(1000, 10, 0.05, 0.5);
+
+    std::size_t before = HeapAllocations.load();
+    double price = simulator.priceBond(bond, vasicek, 0.03, 0.05, 400);
+    std::size_t allocations = HeapAllocations.load() - before;
+
+    REQUIRE(allocations >= 1);
+    REQUIRE(price > 0.0);
+}